@@ -0,0 +1,184 @@
+// asset_pack.cpp - read-only packed asset archive, memory-mapped
+#include "asset_pack.h"
+#include "lz4_block.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static int compareName(const PackEntry& e, const char* name) {
+    return std::strncmp(e.name, name, PACK_NAME_LEN);
+}
+
+// ------------------- Mapped file -------------------
+
+bool MappedFile::open(const char* path) {
+    close();
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER len;
+    if(!GetFileSizeEx(f, &len) || len.QuadPart <= 0) { CloseHandle(f); return false; }
+    HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* p = m ? MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if(!p) { if(m) CloseHandle(m); CloseHandle(f); return false; }
+    fileHandle = f;
+    mappingHandle = m;
+    len_ = size_t(len.QuadPart);
+#else
+    int fd = ::open(path, O_RDONLY);
+    if(fd < 0) return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+    void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file alive
+    if(p == MAP_FAILED) return false;
+    len_ = size_t(st.st_size);
+#endif
+    base = static_cast<const uint8_t*>(p);
+    return true;
+}
+
+void MappedFile::close() {
+    if(base) {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(HANDLE(mappingHandle));
+        CloseHandle(HANDLE(fileHandle));
+        fileHandle = mappingHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(base), len_);
+#endif
+    }
+    base = nullptr;
+    len_ = 0;
+}
+
+// ------------------- Pack -------------------
+
+bool AssetPack::open(const char* path) {
+    close();
+    if(!file.open(path) || file.size() < sizeof(PackHeader)) { close(); return false; }
+    const uint8_t* base = file.data();
+    size_t mappedSize = file.size();
+
+    PackHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    bool ok = std::memcmp(h.magic, PACK_MAGIC, 4) == 0 && h.version == PACK_VERSION &&
+              h.entryCount <= (mappedSize - sizeof(PackHeader)) / sizeof(PackEntry);
+    if(ok) {
+        entries = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+        entryCount = h.entryCount;
+        for(uint32_t i=0; i<entryCount && ok; i++) {
+            const PackEntry& e = entries[i];
+            ok = e.offset <= mappedSize && e.storedSize <= mappedSize - e.offset &&
+                 (e.codec == uint32_t(PackCodec::RAW) ? e.storedSize == e.rawSize : e.codec == uint32_t(PackCodec::LZ4)) &&
+                 std::memchr(e.name, 0, PACK_NAME_LEN) != nullptr &&
+                 (i == 0 || std::strncmp(entries[i-1].name, e.name, PACK_NAME_LEN) < 0);
+        }
+    }
+    if(!ok) { close(); return false; }
+    inflated.assign(entryCount, std::vector<uint8_t>());
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries = nullptr;
+    entryCount = 0;
+    inflated.clear();
+}
+
+const PackEntry* AssetPack::find(const char* name) const {
+    const PackEntry* end = entries + entryCount;
+    const PackEntry* it = std::lower_bound(entries, end, name,
+        [](const PackEntry& e, const char* n) { return compareName(e, n) < 0; });
+    return (it != end && compareName(*it, name) == 0) ? it : nullptr;
+}
+
+bool AssetPack::get(const char* name, AssetView& out) {
+    const PackEntry* e = find(name);
+    if(!e) return false;
+    if(e->codec == uint32_t(PackCodec::RAW)) {
+        out.data = file.data() + e->offset;
+        out.size = size_t(e->rawSize);
+        return true;
+    }
+    std::vector<uint8_t>& buf = inflated[size_t(e - entries)];
+    if(buf.empty() && e->rawSize) {
+        buf.resize(size_t(e->rawSize));
+        if(!lz4DecompressBlock(file.data() + e->offset, size_t(e->storedSize), buf.data(), buf.size())) {
+            buf.clear();
+            return false;
+        }
+    }
+    out.data = buf.data();
+    out.size = buf.size();
+    return true;
+}
+
+bool writeAssetPack(const char* path, std::vector<PackInput> files, bool lz4, std::string& error) {
+    std::sort(files.begin(), files.end(), [](const PackInput& a, const PackInput& b) { return a.name < b.name; });
+    for(size_t i=0; i<files.size(); i++) {
+        if(files[i].name.empty() || files[i].name.size() >= PACK_NAME_LEN) {
+            error = "name too long for the pack index: " + files[i].name;
+            return false;
+        }
+        if(i && files[i].name == files[i-1].name) {
+            error = "duplicate name: " + files[i].name;
+            return false;
+        }
+    }
+
+    std::vector<PackEntry> index(files.size());
+    std::vector<std::vector<uint8_t>> blobs(files.size());
+    uint64_t offset = sizeof(PackHeader) + files.size() * sizeof(PackEntry);
+    for(size_t i=0; i<files.size(); i++) {
+        PackEntry& e = index[i];
+        std::memset(&e, 0, sizeof(e));
+        std::memcpy(e.name, files[i].name.data(), files[i].name.size());
+        e.rawSize = files[i].bytes.size();
+        e.codec = uint32_t(PackCodec::RAW);
+        if(lz4 && !files[i].bytes.empty()) {
+            std::vector<uint8_t> packed;
+            lz4CompressBlock(files[i].bytes.data(), files[i].bytes.size(), packed);
+            if(packed.size() <= files[i].bytes.size() - files[i].bytes.size() / 8) {
+                blobs[i].swap(packed);
+                e.codec = uint32_t(PackCodec::LZ4);
+            }
+        }
+        if(e.codec == uint32_t(PackCodec::RAW)) blobs[i].swap(files[i].bytes);
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        e.offset = offset;
+        e.storedSize = blobs[i].size();
+        offset += e.storedSize;
+    }
+
+    std::FILE* f = std::fopen(path, "wb");
+    if(!f) { error = std::string("cannot create ") + path; return false; }
+    PackHeader h;
+    std::memcpy(h.magic, PACK_MAGIC, 4);
+    h.version = PACK_VERSION;
+    h.entryCount = uint32_t(files.size());
+    h.reserved = 0;
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    if(ok && !index.empty()) ok = std::fwrite(index.data(), sizeof(PackEntry), index.size(), f) == index.size();
+    uint64_t pos = sizeof(PackHeader) + index.size() * sizeof(PackEntry);
+    static const uint8_t zeros[PACK_ALIGN] = {};
+    for(size_t i=0; ok && i<blobs.size(); i++) {
+        ok = std::fwrite(zeros, 1, size_t(index[i].offset - pos), f) == size_t(index[i].offset - pos);
+        if(ok && !blobs[i].empty()) ok = std::fwrite(blobs[i].data(), 1, blobs[i].size(), f) == blobs[i].size();
+        pos = index[i].offset + index[i].storedSize;
+    }
+    if(std::fclose(f) != 0) ok = false;
+    if(!ok) error = std::string("write failed: ") + path;
+    return ok;
+}
@@ -0,0 +1,102 @@
+// asset_pack.h - read-only packed asset archive, memory-mapped
+// Layout (little-endian):
+//   PackHeader | PackEntry[entryCount] sorted by name | blobs
+// Every blob starts on a PACK_ALIGN boundary and is stored raw or as one
+// LZ4 block. Raw blobs are handed out as pointers into the mapping, so
+// sounds and levels are used in place with no read or copy at startup.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static const char PACK_MAGIC[4] = {'D','X','P','K'};
+static const uint32_t PACK_VERSION = 1;
+static const uint32_t PACK_ALIGN = 64;
+static const size_t PACK_NAME_LEN = 48;
+
+enum class PackCodec : uint32_t { RAW = 0, LZ4 = 1 };
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[PACK_NAME_LEN];    // '/'-separated path relative to the packed directory, NUL-padded
+    uint64_t offset;             // from the start of the file
+    uint64_t storedSize;
+    uint64_t rawSize;
+    uint32_t codec;              // PackCodec
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PackHeader) == 16, "pack header layout");
+static_assert(sizeof(PackEntry) == 80, "pack entry layout");
+
+// A whole file mapped read-only (POSIX mmap / Win32 file mapping)
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const char* path);
+    void close();
+    const uint8_t* data() const { return base; }
+    size_t size() const { return len_; }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t len_ = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+struct AssetView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+class AssetPack {
+public:
+    AssetPack() = default;
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    ~AssetPack() { close(); }
+
+    // Map the file and validate the index; nothing else is read
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return file.data() != nullptr; }
+
+    const PackEntry* find(const char* name) const;
+    // Raw entries point into the mapping; LZ4 entries are inflated on first
+    // use into a buffer the pack keeps. Views stay valid until close().
+    // Not thread-safe for LZ4 entries: fetch them from one thread.
+    bool get(const char* name, AssetView& out);
+
+    uint32_t count() const { return entryCount; }
+    const PackEntry& entry(uint32_t i) const { return entries[i]; }
+
+private:
+    MappedFile file;
+    const PackEntry* entries = nullptr;
+    uint32_t entryCount = 0;
+    std::vector<std::vector<uint8_t>> inflated;
+};
+
+// One file for writeAssetPack
+struct PackInput {
+    std::string name;
+    std::vector<uint8_t> bytes;
+};
+
+// Build a pack; with `lz4`, blobs are compressed when that saves at least
+// 1/8 of their size (sounds usually stay raw and remain zero-copy).
+bool writeAssetPack(const char* path, std::vector<PackInput> files, bool lz4, std::string& error);
@@ -0,0 +1,128 @@
+// audio.cpp - preloaded sounds, lock-free event queue and a software mixer thread
+#include "audio.h"
+#include <algorithm>
+#include <chrono>
+#include "sim_clock.h"
+#include "profiler.h"
+
+// ------------------- Sinks -------------------
+
+bool NullAudioSink::open(int r, int) {
+    rate = r;
+    nextTime = -1.0;
+    return true;
+}
+
+void NullAudioSink::pace(size_t frames) {
+    double now = monotonicSeconds();
+    if(nextTime < 0.0 || nextTime < now - 0.1) nextTime = now;
+    nextTime += double(frames) / rate;
+    std::this_thread::sleep_for(std::chrono::duration<double>(nextTime - now));
+}
+
+void NullAudioSink::write(const int16_t*, size_t frames) {
+    pace(frames);
+}
+
+bool WavFileAudioSink::open(int r, int ch) {
+    NullAudioSink::open(r, ch);
+    channels = ch;
+    dataBytes = 0;
+    file = std::fopen(path.c_str(), "wb");
+    return file && writeWavHeader(file, r, ch, 0);
+}
+
+void WavFileAudioSink::write(const int16_t* samples, size_t frames) {
+    if(file) {
+        size_t n = frames * channels;
+        dataBytes += uint32_t(std::fwrite(samples, sizeof(int16_t), n, file) * sizeof(int16_t));
+    }
+    pace(frames);
+}
+
+void WavFileAudioSink::close() {
+    if(!file) return;
+    // patch the sizes now that we know them
+    std::fseek(file, 0, SEEK_SET);
+    writeWavHeader(file, rate, channels, dataBytes);
+    std::fclose(file);
+    file = nullptr;
+}
+
+// ------------------- Engine -------------------
+
+bool AudioEngine::loadSound(SoundId id, const char* path) {
+    return loadWavFile(path, sounds[int(id)]);
+}
+
+bool AudioEngine::loadSound(SoundId id, const uint8_t* data, size_t size, bool borrow) {
+    return decodeWav(data, size, sounds[int(id)], borrow);
+}
+
+bool AudioEngine::start(std::unique_ptr<AudioSink> out) {
+    stop();
+    if(!out || !out->open(MIX_RATE, MIX_CHANNELS)) return false;
+    sink = std::move(out);
+    quit = false;
+    voiceCount = 0;
+    thread = std::thread(&AudioEngine::mixerLoop, this);
+    return true;
+}
+
+void AudioEngine::stop() {
+    if(!thread.joinable()) return;
+    quit = true;
+    thread.join();
+    sink->close();
+    sink.reset();
+}
+
+void AudioEngine::post(SoundId id) {
+    posted++;
+    if(!thread.joinable() || !queue.push(id)) dropped++;
+}
+
+void AudioEngine::startVoice(SoundId id) {
+    const DecodedSound& s = sounds[int(id)];
+    if(s.empty()) {
+        if(fallback) fallback(id);
+        return;
+    }
+    if(voiceCount == MAX_VOICES) {
+        // steal the voice that has been playing longest
+        int oldest = 0;
+        for(int i=1; i<voiceCount; i++) if(voices[i].frame > voices[oldest].frame) oldest = i;
+        voices[oldest] = voices[--voiceCount];
+    }
+    voices[voiceCount++] = {&s, 0};
+}
+
+void AudioEngine::mixBlock(int16_t* out) {
+    int32_t acc[BLOCK_FRAMES * MIX_CHANNELS] = {};
+    for(int v=0; v<voiceCount; ) {
+        Voice& vo = voices[v];
+        size_t n = std::min(BLOCK_FRAMES, vo.sound->frames() - vo.frame);
+        const int16_t* src = vo.sound->data + vo.frame * MIX_CHANNELS;
+        for(size_t i=0; i<n * MIX_CHANNELS; i++) acc[i] += src[i];
+        vo.frame += n;
+        if(vo.frame >= vo.sound->frames()) voices[v] = voices[--voiceCount];
+        else v++;
+    }
+    for(size_t i=0; i<BLOCK_FRAMES * MIX_CHANNELS; i++) {
+        out[i] = int16_t(std::max(-32768, std::min(32767, acc[i])));
+    }
+}
+
+void AudioEngine::mixerLoop() {
+    profileThreadName("mixer");
+    int16_t block[BLOCK_FRAMES * MIX_CHANNELS];
+    while(!quit.load(std::memory_order_relaxed)) {
+        SoundId id;
+        while(queue.pop(id)) startVoice(id);
+        {
+            PROFILE_SCOPE("audio.mix");
+            mixBlock(block);
+        }
+        sink->write(block, BLOCK_FRAMES);
+    }
+}
@@ -0,0 +1,100 @@
+// audio.h - preloaded sounds, lock-free event queue and a software mixer thread
+// Sounds are decoded into memory once at startup. The game thread only
+// posts small events into an SPSC queue (no disk, no OS calls); a mixer
+// thread turns them into voices, mixes overlapping voices and hands fixed
+// blocks to a pluggable AudioSink (WinMM, WAV file, or nothing).
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "spsc_queue.h"
+#include "wav.h"
+
+enum class SoundId : uint8_t { HIT, PADDLE, LOSE, WIN, MENU, COUNT };
+
+class AudioSink {
+public:
+    virtual ~AudioSink() {}
+    virtual bool open(int rate, int channels) = 0;
+    // Called on the mixer thread with one block of interleaved samples;
+    // returns once the sink is ready for the next one (this paces the mixer)
+    virtual void write(const int16_t* samples, size_t frames) = 0;
+    virtual void close() {}
+};
+
+// Throws the audio away, but keeps real-time pacing so voices still end on time
+class NullAudioSink : public AudioSink {
+public:
+    bool open(int rate, int channels) override;
+    void write(const int16_t* samples, size_t frames) override;
+protected:
+    void pace(size_t frames);
+    int rate = MIX_RATE;
+    double nextTime = -1.0;
+};
+
+// Records the mixed output to a WAV file (headless checks on Linux)
+class WavFileAudioSink : public NullAudioSink {
+public:
+    explicit WavFileAudioSink(const std::string& path) : path(path) {}
+    bool open(int rate, int channels) override;
+    void write(const int16_t* samples, size_t frames) override;
+    void close() override;
+private:
+    std::string path;
+    std::FILE* file = nullptr;
+    int channels = MIX_CHANNELS;
+    uint32_t dataBytes = 0;
+};
+
+#ifdef _WIN32
+std::unique_ptr<AudioSink> makeWinMMAudioSink();
+#endif
+
+class AudioEngine {
+public:
+    static const int MAX_VOICES = 16;
+    static const size_t BLOCK_FRAMES = 512;
+
+    ~AudioEngine() { stop(); }
+
+    // Decode once at startup (before start())
+    bool loadSound(SoundId id, const char* path);
+    // `borrow`: reference mixer-format samples in `data` instead of copying
+    // them; `data` must then stay valid until the engine is destroyed
+    bool loadSound(SoundId id, const uint8_t* data, size_t size, bool borrow = false);
+    bool hasSound(SoundId id) const { return !sounds[int(id)].empty(); }
+
+    // Called on the mixer thread for events whose sound isn't loaded
+    void setFallback(void (*fn)(SoundId)) { fallback = fn; }
+
+    bool start(std::unique_ptr<AudioSink> out);
+    void stop();
+    bool running() const { return thread.joinable(); }
+
+    // Game thread only. Never blocks; drops the event if the queue is full.
+    void post(SoundId id);
+
+    uint32_t postedCount() const { return posted; }
+    uint32_t droppedCount() const { return dropped; }
+
+private:
+    struct Voice { const DecodedSound* sound; size_t frame; };
+
+    void mixerLoop();
+    void startVoice(SoundId id);
+    void mixBlock(int16_t* out);
+
+    DecodedSound sounds[int(SoundId::COUNT)];
+    SpscQueue<SoundId, 256> queue;
+    Voice voices[MAX_VOICES];
+    int voiceCount = 0;
+    void (*fallback)(SoundId) = nullptr;
+
+    std::unique_ptr<AudioSink> sink;
+    std::thread thread;
+    std::atomic<bool> quit{false};
+    uint32_t posted = 0, dropped = 0;   // game-thread counters
+};
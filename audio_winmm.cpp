@@ -0,0 +1,78 @@
+// audio_winmm.cpp - waveOut sink for the software mixer (Windows only)
+#ifdef _WIN32
+#include "audio.h"
+#include <vector>
+#include <windows.h>
+#include <mmsystem.h>
+
+#pragma comment(lib, "winmm.lib")
+
+namespace {
+
+// A small ring of waveOut buffers; write() waits for the oldest one to finish
+class WinMMAudioSink : public AudioSink {
+public:
+    static const int BUFFERS = 4;
+
+    bool open(int rate, int channels) override {
+        WAVEFORMATEX fmt = {};
+        fmt.wFormatTag = WAVE_FORMAT_PCM;
+        fmt.nChannels = WORD(channels);
+        fmt.nSamplesPerSec = DWORD(rate);
+        fmt.wBitsPerSample = 16;
+        fmt.nBlockAlign = WORD(channels * 2);
+        fmt.nAvgBytesPerSec = fmt.nSamplesPerSec * fmt.nBlockAlign;
+        event = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if(waveOutOpen(&dev, WAVE_MAPPER, &fmt, (DWORD_PTR)event, 0, CALLBACK_EVENT) != MMSYSERR_NOERROR) {
+            CloseHandle(event);
+            event = NULL;
+            return false;
+        }
+        this->channels = channels;
+        for(int i=0; i<BUFFERS; i++) {
+            ZeroMemory(&hdr[i], sizeof(WAVEHDR));
+            hdr[i].dwFlags = WHDR_DONE;   // free to fill
+        }
+        return true;
+    }
+
+    void write(const int16_t* samples, size_t frames) override {
+        WAVEHDR& h = hdr[next];
+        while(!(h.dwFlags & WHDR_DONE)) WaitForSingleObject(event, 50);
+        if(h.dwFlags & WHDR_PREPARED) waveOutUnprepareHeader(dev, &h, sizeof(WAVEHDR));
+        buf[next].assign(samples, samples + frames * channels);
+        ZeroMemory(&h, sizeof(WAVEHDR));
+        h.lpData = (LPSTR)buf[next].data();
+        h.dwBufferLength = DWORD(frames * channels * sizeof(int16_t));
+        waveOutPrepareHeader(dev, &h, sizeof(WAVEHDR));
+        waveOutWrite(dev, &h, sizeof(WAVEHDR));
+        next = (next + 1) % BUFFERS;
+    }
+
+    void close() override {
+        if(!dev) return;
+        waveOutReset(dev);
+        for(int i=0; i<BUFFERS; i++) {
+            if(hdr[i].dwFlags & WHDR_PREPARED) waveOutUnprepareHeader(dev, &hdr[i], sizeof(WAVEHDR));
+        }
+        waveOutClose(dev);
+        CloseHandle(event);
+        dev = NULL;
+        event = NULL;
+    }
+
+private:
+    HWAVEOUT dev = NULL;
+    HANDLE event = NULL;
+    WAVEHDR hdr[BUFFERS];
+    std::vector<int16_t> buf[BUFFERS];
+    int next = 0;
+    int channels = MIX_CHANNELS;
+};
+
+} // namespace
+
+std::unique_ptr<AudioSink> makeWinMMAudioSink() {
+    return std::unique_ptr<AudioSink>(new WinMMAudioSink());
+}
+#endif
@@ -0,0 +1,51 @@
+// autopilot.cpp - scripted paddle for headless runs
+#include "autopilot.h"
+#include <cmath>
+#include <algorithm>
+
+bool predictBallX(float x, float y, float vx, float vy, float r, float lineY, float& outX) {
+    if(vy >= 0.0f || y < lineY) return false;
+    float t = (y - lineY) / -vy;
+    // fold the straight-line x back into [r, WIN_W - r]
+    float lo = r, span = WIN_W - 2.0f * r;
+    float u = std::fmod(x + vx * t - lo, 2.0f * span);
+    if(u < 0.0f) u += 2.0f * span;
+    outX = lo + (u <= span ? u : 2.0f * span - u);
+    return true;
+}
+
+GameInput Autopilot::update(const GameWorld& w, float dt, SimRng& rng) {
+    GameInput in;
+    for(const SimEvent& e : w.events) {
+        if(e.type != SimEventType::PADDLE_HIT && e.type != SimEventType::LOSE_LIFE) continue;
+        aim = (rng.nextFloat() * 2.0f - 1.0f) * params.aimSpread;
+        error = (rng.nextFloat() * 2.0f - 1.0f) * params.aimError;
+        break;
+    }
+    if(w.ballStuckToPaddle) {
+        in.launch = true;
+        return in;
+    }
+
+    // Earliest arrival among descending balls; otherwise shadow the lowest ball
+    const BallPool& b = w.balls;
+    float target = w.padX + w.padW * 0.5f;
+    float bestT = 1e30f, lowest = 1e30f;
+    for(uint32_t i=0; i<b.count; i++) {
+        float lineY = w.padY + w.padH + b.r[i];
+        float px;
+        if(predictBallX(b.x[i], b.y[i], b.vx[i], b.vy[i], b.r[i], lineY, px)) {
+            float t = (b.y[i] - lineY) / -b.vy[i];
+            if(t < bestT) { bestT = t; target = px; }
+        } else if(bestT == 1e30f && b.y[i] < lowest) {
+            lowest = b.y[i];
+            target = b.x[i];
+        }
+    }
+    target += error - aim * w.padW * 0.5f;
+
+    float move = target - (w.padX + w.padW * 0.5f);
+    float limit = params.maxSpeed * dt;
+    in.padMove = std::max(-limit, std::min(limit, move));
+    return in;
+}
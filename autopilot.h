@@ -0,0 +1,33 @@
+// autopilot.h - scripted paddle for headless runs
+// Predicts where the next descending ball crosses the paddle line (folding
+// the path at the side walls) and drives the paddle there at a limited
+// speed, like a player on the keyboard. Bricks in the way are ignored, so
+// the prediction is only exact for an open path.
+#pragma once
+#include "game_world.h"
+
+struct AutopilotParams {
+    float maxSpeed = 15.0f * KEY_REPEAT_HZ;   // px/s
+    // Where on the paddle to meet the ball, in half-widths from the centre;
+    // re-drawn in [-aimSpread, aimSpread] after every paddle hit
+    float aimSpread = 0.6f;
+    // Random error (px) in each prediction, re-drawn with the aim
+    float aimError = 0.0f;
+};
+
+class Autopilot {
+public:
+    explicit Autopilot(const AutopilotParams& p = AutopilotParams()) : params(p) {}
+
+    // Input for the next step; reads the events of the previous one
+    GameInput update(const GameWorld& w, float dt, SimRng& rng);
+
+    AutopilotParams params;
+
+private:
+    float aim = 0.0f, error = 0.0f;
+};
+
+// x where a ball at (x, y) moving (vx, vy) reaches height `lineY`, bouncing
+// off the side walls; returns false if it never gets there
+bool predictBallX(float x, float y, float vx, float vy, float r, float lineY, float& outX);
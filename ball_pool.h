@@ -0,0 +1,58 @@
+// ball_pool.h - structure-of-arrays ball storage
+// The stepping loop reads position, velocity and radius of every ball in
+// turn, so each lives in its own packed array. Removal swaps the last ball
+// into the hole; order is not stable but is fully deterministic. A ball
+// that must be followed across removals is named by its EntityHandle.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "entity_table.h"
+
+struct BallPool {
+    std::vector<float> x, y, vx, vy, r;
+    std::vector<float> prevX, prevY;    // at the start of the last step (render interpolation)
+    EntityTable ids;
+    uint32_t count = 0;
+
+    void clear() {
+        x.clear(); y.clear(); vx.clear(); vy.clear(); r.clear();
+        prevX.clear(); prevY.clear();
+        ids.clear();
+        count = 0;
+    }
+
+    void reserve(uint32_t n) {
+        x.reserve(n); y.reserve(n); vx.reserve(n); vy.reserve(n); r.reserve(n);
+        prevX.reserve(n); prevY.reserve(n);
+        ids.reserve(n);
+    }
+
+    uint32_t add(float bx, float by, float bvx, float bvy, float br) {
+        x.push_back(bx); y.push_back(by);
+        vx.push_back(bvx); vy.push_back(bvy);
+        r.push_back(br);
+        prevX.push_back(bx); prevY.push_back(by);
+        ids.create();
+        return count++;
+    }
+
+    void remove(uint32_t i) {
+        uint32_t last = ids.destroy(i);
+        count--;
+        x[i] = x[last]; y[i] = y[last];
+        vx[i] = vx[last]; vy[i] = vy[last];
+        r[i] = r[last];
+        prevX[i] = prevX[last]; prevY[i] = prevY[last];
+        x.pop_back(); y.pop_back(); vx.pop_back(); vy.pop_back(); r.pop_back();
+        prevX.pop_back(); prevY.pop_back();
+    }
+
+    EntityHandle handle(uint32_t i) const { return ids.handle(i); }
+    // Index of the ball, or EntityTable::NO_ROW once it is gone
+    uint32_t find(EntityHandle h) const { return ids.find(h); }
+
+    void snapPrevious() {
+        prevX.assign(x.begin(), x.end());
+        prevY.assign(y.begin(), y.end());
+    }
+};
@@ -0,0 +1,145 @@
+// batch_env.cpp - many headless rounds stepped in lockstep, for training agents
+#include "batch_env.h"
+#include "profiler.h"
+#include <algorithm>
+#include <thread>
+
+BatchEnv::BatchEnv(const BatchEnvConfig& config) : cfg(config) {
+    cfg.instances = std::max(1u, cfg.instances);
+    cfg.rows = std::max(1, cfg.rows);
+    cfg.cols = std::max(1, cfg.cols);
+    cfg.frameSkip = std::max(1, cfg.frameSkip);
+    if(!(cfg.stepSeconds > 0.0f)) cfg.stepSeconds = 1.0f / DEFAULT_SIM_HZ;
+
+    makeGridLevel(cfg.rows, cfg.cols, level);
+    levelGrid.build(level);
+
+    for(uint32_t i=0; i<cfg.instances; i++) {
+        instances.emplace_back(new Instance());
+        GameWorld& w = instances.back()->world;
+        w.physics = cfg.physics;
+        w.powerUpChance = cfg.powerUpChance;
+    }
+    unsigned threads = cfg.threads ? cfg.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min(threads, cfg.instances));
+    pool.reset(new ThreadPool(threads));
+    // A few chunks per worker, so one that finishes early takes another
+    grain = std::max(1u, (cfg.instances + threads * 4 - 1) / (threads * 4));
+    restartAll();
+}
+
+void BatchEnv::reset(float* obs, uint8_t* bricks) {
+    restartAll();
+    curActions = nullptr;
+    curObs = obs;
+    curBricks = bricks;
+    run();
+}
+
+// Seeds are a function of cfg.seed alone: every reset() replays the same rounds
+void BatchEnv::restartAll() {
+    SimRng seeds;
+    seeds.seed(cfg.seed);
+    for(auto& in : instances) {
+        GameWorld& w = in->world;
+        w.reseed(seeds.next());
+        w.padX = (WIN_W - w.padW) / 2.0f;
+        w.resetLevel(level, levelGrid);
+        in->steps = 0;
+    }
+}
+
+void BatchEnv::step(const uint8_t* actions, float* obs, uint8_t* bricks, float* rewards, uint8_t* dones) {
+    PROFILE_SCOPE("env.step");
+    curActions = actions;
+    curObs = obs;
+    curBricks = bricks;
+    curRewards = rewards;
+    curDones = dones;
+    run();
+}
+
+void BatchEnv::run() {
+    uint32_t chunks = (size() + grain - 1) / grain;
+    nextChunk.store(0, std::memory_order_relaxed);
+    // Only `this` is captured, so submitting doesn't allocate
+    unsigned tasks = std::min(pool->size(), chunks);
+    for(unsigned t=0; t<tasks; t++) {
+        pool->submit([this]() {
+            uint32_t chunks = (size() + grain - 1) / grain;
+            for(uint32_t c; (c = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks; ) {
+                uint32_t begin = c * grain, end = std::min(size(), begin + grain);
+                if(curActions) stepRange(begin, end);
+                else for(uint32_t i=begin; i<end; i++) writeObs(i);
+            }
+        });
+    }
+    pool->wait();
+}
+
+void BatchEnv::stepRange(uint32_t begin, uint32_t end) {
+    const float dt = cfg.stepSeconds;
+    for(uint32_t i=begin; i<end; i++) {
+        Instance& in = *instances[i];
+        GameWorld& w = in.world;
+        GameInput input;
+        float move = w.padSpeed * KEY_REPEAT_HZ * dt;
+        switch(EnvAction(curActions[i])) {
+            case EnvAction::LEFT:   input.padMove = -move; break;
+            case EnvAction::RIGHT:  input.padMove = move; break;
+            case EnvAction::LAUNCH: input.launch = true; break;
+            default: break;
+        }
+        int score = w.score, lives = w.lives;
+        for(int s=0; s<cfg.frameSkip && !w.roundOver(); s++) w.step(input, dt);
+        curRewards[i] = float(w.score - score) + cfg.lifePenalty * float(lives - w.lives);
+
+        uint8_t done = ENV_RUNNING;
+        in.steps++;
+        if(w.roundOver()) done = ENV_TERMINATED;
+        else if(cfg.maxEpisodeSteps && in.steps >= cfg.maxEpisodeSteps) done = ENV_TRUNCATED;
+        curDones[i] = done;
+        if(done != ENV_RUNNING) {
+            w.resetLevel(level, levelGrid);
+            in.steps = 0;
+            in.episodes++;
+        }
+        writeObs(i);
+    }
+}
+
+void BatchEnv::writeObs(uint32_t i) {
+    const GameWorld& w = instances[i]->world;
+    float* o = curObs + size_t(i) * obsSize();
+    o[0] = (w.padX + w.padW * 0.5f) * (1.0f / WIN_W);
+    o[1] = w.padW * (1.0f / WIN_W);
+    o[2] = w.ballStuckToPaddle ? 1.0f : 0.0f;
+    o[3] = float(w.balls.count);
+    o[4] = float(w.lives);
+    o[5] = level.count ? float(w.aliveCount()) / float(level.count) : 0.0f;
+    o += OBS_HEADER;
+    // The first obsBalls rows of the pool; missing balls are all zeros
+    const BallPool& b = w.balls;
+    uint32_t n = std::min(b.count, cfg.obsBalls);
+    for(uint32_t k=0; k<n; k++, o += OBS_PER_BALL) {
+        o[0] = b.x[k] * (1.0f / WIN_W);
+        o[1] = b.y[k] * (1.0f / WIN_H);
+        o[2] = b.vx[k] * (1.0f / BALL_SPEED_X);
+        o[3] = b.vy[k] * (1.0f / BALL_SPEED_Y);
+        o[4] = 1.0f;
+    }
+    std::fill(o, o + OBS_PER_BALL * (cfg.obsBalls - n), 0.0f);
+
+    if(curBricks) {
+        // Bytes of the alive words, low byte first, on any host
+        uint8_t* out = curBricks + size_t(i) * brickBytes();
+        const uint64_t* words = w.bricks.aliveBits.data();
+        for(uint32_t k=0, n=brickBytes(); k<n; k++) out[k] = uint8_t(words[k >> 3] >> ((k & 7) * 8));
+    }
+}
+
+uint64_t BatchEnv::episodes() const {
+    uint64_t n = 0;
+    for(const auto& in : instances) n += in->episodes;
+    return n;
+}
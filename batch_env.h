@@ -0,0 +1,100 @@
+// batch_env.h - many headless rounds stepped in lockstep, for training agents
+// One step() takes an action for every instance and writes every
+// observation, reward and done flag into caller-owned contiguous buffers:
+// instance i owns obs[i*obsSize() ..], bricks[i*brickBytes() ..], rewards[i]
+// and dones[i]. Instances are split into chunks that the thread pool's
+// workers claim in turn, as BoardSet does with boards. Steady-state steps
+// don't allocate: restarting a round copies the level into the storage the
+// instance already has.
+// An instance whose round ended is reset within the same step, so the
+// observation written next to done != 0 is the first one of its next round.
+// Each instance owns its seed, so results don't depend on the thread count.
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "game_world.h"
+#include "thread_pool.h"
+
+enum class EnvAction : uint8_t { NOOP, LEFT, RIGHT, LAUNCH, COUNT };
+
+// dones[i]: why instance i's round ended this step
+static const uint8_t ENV_RUNNING = 0;
+static const uint8_t ENV_TERMINATED = 1;   // out of lives or level cleared
+static const uint8_t ENV_TRUNCATED = 2;    // hit maxEpisodeSteps
+
+struct BatchEnvConfig {
+    uint32_t instances = 256;
+    unsigned threads = 0;                // 0 = one per hardware thread
+    int rows = 4, cols = 8;              // the wall every instance plays
+    uint32_t obsBalls = 1;               // balls described per observation
+    int frameSkip = 1;                   // simulation steps per env step, action repeated
+    float stepSeconds = 1.0f / DEFAULT_SIM_HZ;
+    PhysicsMode physics = PhysicsMode::FLOAT;
+    float powerUpChance = 0.0f;
+    float lifePenalty = 0.0f;            // added to the reward per life lost (e.g. -10)
+    uint32_t maxEpisodeSteps = 0;        // 0 = rounds only end in play
+    uint64_t seed = 1;
+};
+
+class BatchEnv {
+public:
+    // Observation layout (floats, positions in window units 0..1, velocities
+    // in units of the serve speed):
+    //   paddle centre x, paddle width, ball stuck (0/1), balls in play,
+    //   lives, share of bricks alive, then per ball x, y, vx, vy, present
+    static const uint32_t OBS_HEADER = 6;
+    static const uint32_t OBS_PER_BALL = 5;
+
+    // Out-of-range settings are clamped (at least one instance, one step...)
+    explicit BatchEnv(const BatchEnvConfig& cfg);
+
+    uint32_t size() const { return uint32_t(instances.size()); }
+    uint32_t obsSize() const { return OBS_HEADER + OBS_PER_BALL * cfg.obsBalls; }
+    // Brick-alive bitmap: bit j of byte k is brick 8k+j of the level, in the
+    // same order in every instance and every round
+    uint32_t brickBytes() const { return (level.count + 7) / 8; }
+    uint32_t actionCount() const { return uint32_t(EnvAction::COUNT); }
+    unsigned threads() const { return pool->size(); }
+    const BatchEnvConfig& config() const { return cfg; }
+
+    // Start every instance over and write the first observations. `bricks`
+    // may be null when the bitmap isn't wanted (here and in step()).
+    void reset(float* obs, uint8_t* bricks);
+    // One env step of every instance; actions are EnvAction values
+    // (anything else is NOOP)
+    void step(const uint8_t* actions, float* obs, uint8_t* bricks, float* rewards, uint8_t* dones);
+
+    const GameWorld& world(uint32_t i) const { return instances[i]->world; }
+    uint64_t episodes() const;           // rounds finished since construction
+
+private:
+    struct Instance {
+        GameWorld world;
+        uint32_t steps = 0;
+        uint64_t episodes = 0;
+    };
+
+    void stepRange(uint32_t begin, uint32_t end);
+    void writeObs(uint32_t i);
+    void restartAll();
+    // Step (curActions set) or only observe every instance, chunk by chunk
+    void run();
+
+    BatchEnvConfig cfg;
+    BrickStore level;                    // the wall, grid-ordered, copied in on every reset
+    BrickGrid levelGrid;
+    // One allocation per instance, as in BoardSet
+    std::vector<std::unique_ptr<Instance>> instances;
+    std::unique_ptr<ThreadPool> pool;
+    uint32_t grain = 1;
+    std::atomic<uint32_t> nextChunk{0};
+
+    // The buffers of the call in progress
+    const uint8_t* curActions = nullptr;
+    float* curObs = nullptr;
+    uint8_t* curBricks = nullptr;
+    float* curRewards = nullptr;
+    uint8_t* curDones = nullptr;
+};
@@ -0,0 +1,61 @@
+// batch_env_c.cpp - C interface to BatchEnv
+#include "batch_env_c.h"
+#include "batch_env.h"
+
+struct dx_env {
+    BatchEnv env;
+    explicit dx_env(const BatchEnvConfig& cfg) : env(cfg) {}
+};
+
+void dx_env_default_config(dx_env_config* cfg) {
+    if(!cfg) return;
+    BatchEnvConfig d;
+    cfg->instances = d.instances;
+    cfg->threads = d.threads;
+    cfg->rows = d.rows;
+    cfg->cols = d.cols;
+    cfg->obs_balls = d.obsBalls;
+    cfg->frame_skip = d.frameSkip;
+    cfg->step_seconds = d.stepSeconds;
+    cfg->fixed_physics = d.physics == PhysicsMode::FIXED;
+    cfg->power_up_chance = d.powerUpChance;
+    cfg->life_penalty = d.lifePenalty;
+    cfg->max_episode_steps = d.maxEpisodeSteps;
+    cfg->seed = d.seed;
+}
+
+dx_env* dx_env_create(const dx_env_config* cfg) {
+    if(!cfg) return nullptr;
+    BatchEnvConfig c;
+    c.instances = cfg->instances;
+    c.threads = cfg->threads;
+    c.rows = cfg->rows;
+    c.cols = cfg->cols;
+    c.obsBalls = cfg->obs_balls;
+    c.frameSkip = cfg->frame_skip;
+    c.stepSeconds = cfg->step_seconds;
+    c.physics = cfg->fixed_physics ? PhysicsMode::FIXED : PhysicsMode::FLOAT;
+    c.powerUpChance = cfg->power_up_chance;
+    c.lifePenalty = cfg->life_penalty;
+    c.maxEpisodeSteps = cfg->max_episode_steps;
+    c.seed = cfg->seed;
+    // No exception may cross into C
+    try {
+        return new dx_env(c);
+    } catch(...) {
+        return nullptr;
+    }
+}
+
+void dx_env_destroy(dx_env* env) { delete env; }
+
+uint32_t dx_env_size(const dx_env* env) { return env->env.size(); }
+uint32_t dx_env_obs_size(const dx_env* env) { return env->env.obsSize(); }
+uint32_t dx_env_brick_bytes(const dx_env* env) { return env->env.brickBytes(); }
+uint32_t dx_env_action_count(const dx_env* env) { return env->env.actionCount(); }
+
+void dx_env_reset(dx_env* env, float* obs, uint8_t* bricks) { env->env.reset(obs, bricks); }
+
+void dx_env_step(dx_env* env, const uint8_t* actions, float* obs, uint8_t* bricks, float* rewards, uint8_t* dones) {
+    env->env.step(actions, obs, bricks, rewards, dones);
+}
@@ -0,0 +1,64 @@
+/* batch_env_c.h - C interface to BatchEnv (batch_env.h) for other languages
+ * Plain functions over an opaque handle, fixed-width types only, so it can be
+ * loaded from ctypes/cffi, Julia, Lua... The buffers are the caller's and are
+ * laid out as BatchEnv documents: instance i owns obs[i*obs_size ..],
+ * bricks[i*brick_bytes ..], rewards[i] and dones[i]. Nothing here allocates
+ * after dx_env_create(). */
+#ifndef DX_BATCH_ENV_C_H
+#define DX_BATCH_ENV_C_H
+
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(DXENV_SHARED)
+#define DXENV_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define DXENV_API __attribute__((visibility("default")))
+#else
+#define DXENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dx_env dx_env;
+
+/* Same fields and meaning as BatchEnvConfig */
+typedef struct dx_env_config {
+    uint32_t instances;
+    uint32_t threads;               /* 0 = one per hardware thread */
+    int32_t rows, cols;
+    uint32_t obs_balls;
+    int32_t frame_skip;
+    float step_seconds;
+    int32_t fixed_physics;          /* nonzero = Q16.16 physics */
+    float power_up_chance;
+    float life_penalty;
+    uint32_t max_episode_steps;     /* 0 = never truncate */
+    uint64_t seed;
+} dx_env_config;
+
+/* Actions and done values, as EnvAction and ENV_* */
+enum { DX_ENV_NOOP = 0, DX_ENV_LEFT = 1, DX_ENV_RIGHT = 2, DX_ENV_LAUNCH = 3 };
+enum { DX_ENV_RUNNING = 0, DX_ENV_TERMINATED = 1, DX_ENV_TRUNCATED = 2 };
+
+DXENV_API void dx_env_default_config(dx_env_config* cfg);
+/* NULL if cfg is NULL or the environment could not be built */
+DXENV_API dx_env* dx_env_create(const dx_env_config* cfg);
+DXENV_API void dx_env_destroy(dx_env* env);
+
+DXENV_API uint32_t dx_env_size(const dx_env* env);
+DXENV_API uint32_t dx_env_obs_size(const dx_env* env);        /* floats per instance */
+DXENV_API uint32_t dx_env_brick_bytes(const dx_env* env);     /* bitmap bytes per instance */
+DXENV_API uint32_t dx_env_action_count(const dx_env* env);
+
+/* bricks may be NULL in both calls */
+DXENV_API void dx_env_reset(dx_env* env, float* obs, uint8_t* bricks);
+DXENV_API void dx_env_step(dx_env* env, const uint8_t* actions, float* obs, uint8_t* bricks,
+                           float* rewards, uint8_t* dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
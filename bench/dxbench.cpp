@@ -0,0 +1,326 @@
+// dxbench.cpp - headless benchmark suite with machine-readable output
+// Covers the per-tick simulation at several brick counts, level resets,
+// scoreboard inserts, render-command generation (no GL context needed), the
+// power-up pass over a crowded pool, the particle pool under each update
+// kernel, multi-board frames on the thread pool and the batch training
+// environment.
+// Each result is printed as a line and, with --json, written as
+//   {"suite": "dxbench", "results": [{"name", "params", "value", "unit"}, ...]}
+// so runs from different releases can be diffed. --quick shortens every case.
+// Build: cmake --build <dir> --target dxbench (or `bench`, which also writes bench.json)
+// Usage: dxbench [--quick] [--json <file>]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "batch_env.h"
+#include "board_set.h"
+#include "game_world.h"
+#include "particles.h"
+#include "render_batch.h"
+#include "score_log.h"
+#include "text_batch.h"
+
+struct BenchResult {
+    std::string name;
+    std::string params;       // JSON object body, e.g. "\"rows\": 4, \"cols\": 8"
+    double value;
+    const char* unit;
+};
+
+static std::vector<BenchResult> results;
+static double budget = 0.5;   // seconds per case
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void report(const std::string& name, const std::string& params, double value, const char* unit) {
+    results.push_back({name, params, value, unit});
+    std::printf("%-22s %-40s %14.2f %s\n", name.c_str(), params.c_str(), value, unit);
+}
+
+static std::string gridParams(int rows, int cols) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "\"rows\": %d, \"cols\": %d, \"bricks\": %d", rows, cols, rows * cols);
+    return buf;
+}
+
+// Keep the paddle under the first ball and the floor closed so the round runs
+// for the whole budget; a cleared level starts over (counted in the time)
+static void benchStep(int rows, int cols, PhysicsMode physics) {
+    GameWorld w(7);
+    w.physics = physics;
+    w.powerUpChance = 0.0f;
+    w.floorBounces = true;
+    w.resetLevel(rows, cols);
+    const float dt = 1.0f / DEFAULT_SIM_HZ;
+    long ticks = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        for(int i=0; i<256; i++) {
+            GameInput in;
+            in.launch = true;
+            in.hasPadTarget = true;
+            in.padTarget = w.balls.x[0] + float((ticks >> 9) % 5 - 2) * 9.0f;
+            w.step(in, dt);
+            if(w.roundOver()) w.resetLevel(rows, cols);
+            ticks++;
+        }
+        elapsed = now() - t0;
+    }
+    std::string params = gridParams(rows, cols);
+    if(physics == PhysicsMode::FIXED) params += ", \"physics\": \"fixed\"";
+    report("sim.step", params, ticks / elapsed, "ticks/s");
+}
+
+static void benchReset(int rows, int cols) {
+    GameWorld w(7);
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        w.resetLevel(rows, cols);
+        n++;
+        elapsed = now() - t0;
+    }
+    report("world.resetLevel", gridParams(rows, cols), elapsed / n * 1e6, "us/call");
+}
+
+// A stream of runs against the top-12 board, most of them below the cut
+static void benchScoreboard() {
+    static const char* names[3] = {"Player 1", "Player 2", "Player 3"};
+    SimRng rng;
+    rng.seed(3);
+    std::vector<int> scores(1 << 16);
+    for(int& s : scores) s = int(rng.next() % 5000) * 10;
+    TopScores board(12);
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        for(int i=0; i<4096; i++, n++) board.insert(names[n % 3], scores[n & 0xFFFF]);
+        elapsed = now() - t0;
+    }
+    report("scoreboard.insert", "\"k\": 12", elapsed / n * 1e9, "ns/op");
+}
+
+static void benchBrickMesh(int rows, int cols) {
+    BrickStore s;
+    makeGridLevel(rows, cols, s);
+    BrickMesh mesh;
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        mesh.build(s);
+        n++;
+        elapsed = now() - t0;
+    }
+    report("render.brickMesh", gridParams(rows, cols), elapsed / n * 1e6, "us/build");
+}
+
+// The per-frame dynamic batch: paddle, every ball, and the falling capsules
+static void benchDynamicBatch(int balls) {
+    ShapeMeshes shapes;
+    shapes.build(120, 20);
+    RenderBatch batch;
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        batch.clear();
+        shapes.appendPaddle(batch, 400.0f, 60.0f);
+        for(int i=0; i<balls; i++) shapes.appendBall(batch, float(i % WIN_W), float(100 + i % 500), 10.0f);
+        for(int i=0; i<8; i++) batch.rect(50.0f * i, 300.0f, 50.0f * i + POWERUP_W, 300.0f + POWERUP_H, {1, 1, 1, 1});
+        n++;
+        elapsed = now() - t0;
+    }
+    char params[32];
+    std::snprintf(params, sizeof(params), "\"balls\": %d", balls);
+    report("render.dynamicBatch", params, elapsed / n * 1e6, "us/frame");
+}
+
+// HUD-sized strings against a synthetic 9x15 monospace atlas
+static void benchTextLayout() {
+    FontMetrics font;
+    for(int c=GLYPH_FIRST; c<=GLYPH_LAST; c++) font.glyphs[c - GLYPH_FIRST] = {0, 0, 1, 1, 9, 15, 0, -3, 9};
+    font.ready = true;
+    std::vector<TextVertex> verts;
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        for(int i=0; i<64; i++, n++) {
+            verts.clear();
+            layoutText(font, 20, 20, "Score: 123450  Lives: 3  Player: Player 1", {1, 1, 1, 1}, verts);
+        }
+        elapsed = now() - t0;
+    }
+    report("render.textLayout", "\"chars\": 40", elapsed / n * 1e9, "ns/string");
+}
+
+// One displayed frame of effects at a steady live count: top the pool back
+// up, update at 60 Hz and build the point batch
+static void benchParticles(uint32_t target, ParticleKernel k) {
+    selectParticleKernel(k);
+    if(activeParticleKernel() != k) return;
+    ParticlePool pool(1u << 18);
+    std::vector<RenderVertex> points;
+    SimRng rng;
+    rng.seed(5);
+    long n = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        while(pool.live() < target) {
+            pool.burst(rng.nextFloat() * WIN_W, 200.0f + rng.nextFloat() * 400.0f,
+                       std::min(64u, target - pool.live()), {1, 0.5f, 0.2f, 1}, 300.0f, 2.0f);
+        }
+        pool.update(1.0f / 60.0f);
+        pool.build(points);
+        n++;
+        elapsed = now() - t0;
+    }
+    char params[64];
+    std::snprintf(params, sizeof(params), "\"particles\": %u, \"kernel\": \"%s\"", target, particleKernelName(k));
+    report("particles.frame", params, elapsed / n * 1e6, "us/frame");
+}
+
+// Fall and catch for a pool of falling capsules at a steady count (caught
+// and lost ones are replaced); the ball stays on the paddle so the tick is
+// almost all power-up work
+static void benchPowerUps(uint32_t target) {
+    GameWorld w(9);
+    w.resetLevel(4, 8);
+    w.powerUps.reserve(target);
+    SimRng rng;
+    rng.seed(3);
+    const float dt = 1.0f / DEFAULT_SIM_HZ;
+    GameInput in;
+    long ticks = 0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        for(int i=0; i<16; i++) {
+            while(w.powerUps.count < target) {
+                w.powerUps.add(rng.nextFloat() * (WIN_W - POWERUP_W), 100.0f + rng.nextFloat() * 500.0f,
+                               PowerUpType::MULTI_BALL);
+            }
+            w.step(in, dt);
+            ticks++;
+        }
+        elapsed = now() - t0;
+    }
+    char params[64];
+    std::snprintf(params, sizeof(params), "\"powerUps\": %u", target);
+    report("sim.powerUps", params, elapsed * 1e9 / (double(ticks) * target), "ns/entity");
+}
+
+// Autopilot boards with closed floors, two steps per frame: the frame time is
+// the barrier-to-barrier wall time, next to the slowest single board in it.
+// With enough cores the two converge; on one core the frame is their sum.
+static void benchBoards(uint32_t n) {
+    BoardSet set;
+    set.resize(n);
+    for(uint32_t i=0; i<n; i++) {
+        Board& b = set[i];
+        b.world.reseed(11 + i);
+        b.world.powerUpChance = 0.0f;
+        b.world.floorBounces = true;
+        b.world.resetLevel(20, 40);
+        b.autopilot = true;
+        b.pilotRng.seed(i + 1);
+    }
+    const float dt = 1.0f / DEFAULT_SIM_HZ;
+    long frames = 0;
+    double slowest = 0.0;
+    double t0 = now(), elapsed = 0.0;
+    while(elapsed < budget) {
+        set.advance(2, dt);
+        slowest += set.slowestBoardMs();
+        frames++;
+        for(uint32_t i=0; i<n; i++) {
+            if(set[i].world.roundOver()) set[i].world.resetLevel(20, 40);
+        }
+        elapsed = now() - t0;
+    }
+    char params[96];
+    std::snprintf(params, sizeof(params), "\"boards\": %u, \"threads\": %u", n, set.threads());
+    report("sim.boards", params, elapsed * 1e6 / frames, "us/frame");
+    report("sim.boards.slowest", params, slowest * 1e3 / frames, "us/frame");
+}
+
+// Environment steps per second over a whole batch, bitmap included. The
+// actions track the first ball with a little noise, so rounds last and end
+// the way an agent's do (auto-resets are in the time).
+static void benchBatchEnv(uint32_t instances) {
+    BatchEnvConfig cfg;
+    cfg.instances = instances;
+    cfg.maxEpisodeSteps = 20000;
+    BatchEnv env(cfg);
+    const uint32_t obsSize = env.obsSize();
+    std::vector<float> obs(size_t(instances) * obsSize), rewards(instances);
+    std::vector<uint8_t> bricks(size_t(instances) * env.brickBytes()), dones(instances), actions(instances);
+    env.reset(obs.data(), bricks.data());
+    SimRng rng;
+    rng.seed(5);
+    long steps = 0;
+    double stepping = 0.0, t0 = now();
+    while(now() - t0 < budget) {
+        for(uint32_t i=0; i<instances; i++) {
+            const float* o = &obs[size_t(i) * obsSize];
+            float pad = o[0], ball = o[BatchEnv::OBS_HEADER];
+            EnvAction a = o[2] > 0.5f ? EnvAction::LAUNCH
+                        : (ball < pad - 0.01f ? EnvAction::LEFT : (ball > pad + 0.01f ? EnvAction::RIGHT : EnvAction::NOOP));
+            if((rng.next() & 7) == 0) a = EnvAction(rng.next() % uint32_t(EnvAction::COUNT));
+            actions[i] = uint8_t(a);
+        }
+        double s0 = now();
+        env.step(actions.data(), obs.data(), bricks.data(), rewards.data(), dones.data());
+        stepping += now() - s0;
+        steps += instances;
+    }
+    char params[96];
+    std::snprintf(params, sizeof(params), "\"instances\": %u, \"threads\": %u", instances, env.threads());
+    report("env.step", params, steps / stepping, "steps/s");
+}
+
+static bool writeJson(const char* path) {
+    FILE* f = std::fopen(path, "w");
+    if(!f) return false;
+    std::fprintf(f, "{\n  \"suite\": \"dxbench\",\n  \"budgetSeconds\": %g,\n  \"results\": [\n", budget);
+    for(size_t i=0; i<results.size(); i++) {
+        const BenchResult& r = results[i];
+        std::fprintf(f, "    {\"name\": \"%s\", \"params\": {%s}, \"value\": %.4f, \"unit\": \"%s\"}%s\n",
+                     r.name.c_str(), r.params.c_str(), r.value, r.unit, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    for(int i=1; i<argc; i++) {
+        if(std::strcmp(argv[i], "--quick") == 0) budget = 0.05;
+        else if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else {
+            std::fprintf(stderr, "usage: dxbench [--quick] [--json <file>]\n");
+            return 2;
+        }
+    }
+    static const int GRIDS[][2] = {{4, 8}, {20, 40}, {100, 100}, {300, 300}};
+    for(const auto& g : GRIDS) benchStep(g[0], g[1], PhysicsMode::FLOAT);
+    for(const auto& g : GRIDS) benchStep(g[0], g[1], PhysicsMode::FIXED);
+    for(const auto& g : GRIDS) benchReset(g[0], g[1]);
+    benchScoreboard();
+    for(const auto& g : GRIDS) benchBrickMesh(g[0], g[1]);
+    for(int balls : {1, 100, 5000}) benchDynamicBatch(balls);
+    benchTextLayout();
+    benchPowerUps(100000);
+    for(ParticleKernel k : {ParticleKernel::SCALAR, ParticleKernel::SSE2, ParticleKernel::AVX2}) {
+        benchParticles(100000, k);
+    }
+    for(uint32_t n : {1u, 4u, 16u}) benchBoards(n);
+    for(uint32_t n : {256u, 4096u}) benchBatchEnv(n);
+    if(jsonPath && !writeJson(jsonPath)) {
+        std::fprintf(stderr, "cannot write %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+// board_set.cpp - several independent boards stepped side by side
+#include "board_set.h"
+#include "profiler.h"
+#include "sim_clock.h"
+#include <algorithm>
+#include <thread>
+
+void BoardSet::resize(uint32_t n, unsigned threads) {
+    boards.clear();
+    for(uint32_t i=0; i<n; i++) boards.emplace_back(new Board());
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1u, std::min(threads, n));
+    if(!pool || pool->size() != threads) {
+        pool.reset();
+        pool.reset(new ThreadPool(threads));
+    }
+}
+
+void BoardSet::runBoard(uint32_t i) {
+    PROFILE_SCOPE("sim.board");
+    double t0 = monotonicSeconds();
+    Board& b = *boards[i];
+    b.events.clear();
+    GameWorld& w = b.world;
+    for(int s=0; s<frameSteps && !w.roundOver(); s++) {
+        GameInput in;
+        if(b.autopilot) in = b.pilot.update(w, frameDt, b.pilotRng);
+        else if(size_t(s) < b.inputs.size()) in = b.inputs[s];
+        w.step(in, frameDt);
+        b.events.insert(b.events.end(), w.events.begin(), w.events.end());
+    }
+    b.stepMs = (monotonicSeconds() - t0) * 1e3;
+}
+
+void BoardSet::advance(int steps, float dt) {
+    double t0 = monotonicSeconds();
+    frameSteps = steps;
+    frameDt = dt;
+    // One task per worker, each taking the next unclaimed board, so a slow
+    // board doesn't hold up a fixed share of the others. The capture fits
+    // std::function's inline storage: submitting doesn't allocate.
+    nextBoard.store(0, std::memory_order_relaxed);
+    for(unsigned t=0; t<pool->size(); t++) {
+        pool->submit([this]() {
+            for(uint32_t i; (i = nextBoard.fetch_add(1, std::memory_order_relaxed)) < size(); ) runBoard(i);
+        });
+    }
+    pool->wait();
+    advanceMs = (monotonicSeconds() - t0) * 1e3;
+}
+
+bool BoardSet::allOver() const {
+    for(const auto& b : boards) {
+        if(!b->world.roundOver()) return false;
+    }
+    return true;
+}
+
+double BoardSet::slowestBoardMs() const {
+    double ms = 0.0;
+    for(const auto& b : boards) ms = std::max(ms, b->stepMs);
+    return ms;
+}
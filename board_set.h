@@ -0,0 +1,60 @@
+// board_set.h - several independent boards stepped side by side
+// Each board is its own GameWorld with its own seed, input and events, so
+// boards share nothing while they step. advance() hands every board to the
+// thread pool and returns once all of them have run the frame's steps: the
+// per-frame barrier, after which the caller reads and draws them freely. A
+// board is fed either by per-step inputs the caller queued (a player) or by
+// its own autopilot, and its results don't depend on the thread count.
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "autopilot.h"
+#include "game_world.h"
+#include "thread_pool.h"
+
+// Cache-line aligned (and so padded to whole lines): the fields one worker
+// writes every step never share a line with the next board's
+struct alignas(64) Board {
+    GameWorld world;
+    bool autopilot = false;
+    Autopilot pilot;
+    SimRng pilotRng;
+    // Inputs for this frame's steps (player boards); steps without one are idle
+    std::vector<GameInput> inputs;
+    // Everything this frame's steps raised, in order
+    std::vector<SimEvent> events;
+    double stepMs = 0.0;                 // time this board took in the last advance()
+};
+
+class BoardSet {
+public:
+    // n boards on up to `threads` workers (0 = one per hardware thread);
+    // never more workers than boards. Boards come back default-constructed.
+    void resize(uint32_t n, unsigned threads = 0);
+    uint32_t size() const { return uint32_t(boards.size()); }
+    Board& operator[](uint32_t i) { return *boards[i]; }
+    const Board& operator[](uint32_t i) const { return *boards[i]; }
+
+    // Run `steps` steps of dt seconds on every board still in its round,
+    // then wait for all of them
+    void advance(int steps, float dt);
+    bool allOver() const;
+
+    unsigned threads() const { return pool ? pool->size() : 0; }
+    // Wall time of the last advance() and the slowest single board in it
+    double lastAdvanceMs() const { return advanceMs; }
+    double slowestBoardMs() const;
+
+private:
+    void runBoard(uint32_t i);
+
+    // One (aligned) allocation per board, so boards never move
+    std::vector<std::unique_ptr<Board>> boards;
+    std::unique_ptr<ThreadPool> pool;
+    std::atomic<uint32_t> nextBoard{0};
+    int frameSteps = 0;
+    float frameDt = 0.0f;
+    double advanceMs = 0.0;
+};
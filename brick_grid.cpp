@@ -0,0 +1,63 @@
+// brick_grid.cpp - uniform grid broadphase over the level's bricks
+#include "brick_grid.h"
+#include <cmath>
+
+void BrickGrid::build(BrickStore& store) {
+    cols = rowsN = 0;
+    bigEnd = 0;
+    cellStart.clear();
+    uint32_t n = store.count;
+    if(n == 0) return;
+
+    float minX = store.x[0], minY = store.y[0];
+    float maxX = minX, maxY = minY;
+    double sumSize = 0.0;
+    for(uint32_t i=0; i<n; i++) {
+        minX = std::min(minX, store.x[i]); maxX = std::max(maxX, store.x[i]);
+        minY = std::min(minY, store.y[i]); maxY = std::max(maxY, store.y[i]);
+        sumSize += std::max(store.w[i], store.h[i]);
+    }
+    originX = minX; originY = minY;
+    cellSize = std::max(4.0f, float(sumSize / n));
+    // keep the cell count in proportion to the brick count for sparse levels
+    float extent = std::max(maxX - minX, maxY - minY);
+    float maxCells = 4.0f * n + 64.0f;
+    while((extent / cellSize) * (extent / cellSize) > maxCells) cellSize *= 2.0f;
+    invCell = 1.0f / cellSize;
+    cols = int(std::floor((maxX - minX) * invCell)) + 1;
+    rowsN = int(std::floor((maxY - minY) * invCell)) + 1;
+
+    // Counting sort by home cell; the oversized bricks take the slot past
+    // the last cell
+    size_t cells = size_t(cols) * rowsN;
+    float bigSize = 2.0f * cellSize;
+    std::vector<uint32_t> home(n);
+    std::vector<uint32_t> fill(cells + 1, 0u);
+    maxW = maxH = 0.0f;
+    for(uint32_t i=0; i<n; i++) {
+        if(store.w[i] > bigSize || store.h[i] > bigSize) {
+            home[i] = uint32_t(cells);
+        } else {
+            home[i] = uint32_t(cellY(store.y[i]) * cols + cellX(store.x[i]));
+            maxW = std::max(maxW, store.w[i]); maxH = std::max(maxH, store.h[i]);
+        }
+        fill[home[i]]++;
+    }
+    cellStart.assign(cells + 1, 0u);
+    for(size_t c=0; c<cells; c++) cellStart[c + 1] = cellStart[c] + fill[c];
+    bigEnd = n;
+
+    std::copy(cellStart.begin(), cellStart.end(), fill.begin());
+    std::vector<uint32_t> order(n);
+    for(uint32_t i=0; i<n; i++) order[fill[home[i]]++] = i;
+
+    BrickStore sorted;
+    sorted.reserve(n);
+    sorted.palette = store.palette;
+    for(uint32_t k=0; k<n; k++) {
+        uint32_t i = order[k];
+        sorted.add(store.x[i], store.y[i], store.w[i], store.h[i], store.paletteIndex[i], store.hp[i], store.id[i]);
+        if(!store.alive(i)) sorted.setAlive(k, false);
+    }
+    store = std::move(sorted);
+}
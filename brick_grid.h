@@ -0,0 +1,49 @@
+// brick_grid.h - uniform grid broadphase over the level's bricks
+// Built once per level. Every brick belongs to the cell holding its
+// bottom-left corner, and build() re-orders the BrickStore so each cell's
+// bricks are contiguous; cells of one grid row are then one contiguous run
+// too, which is what the SIMD narrowphase wants. Bricks more than two cells
+// wide or tall go to one run after all the cells that every query scans, so
+// a few long bars don't widen every query. Dead bricks stay in place;
+// callers skip them, which keeps kills O(1).
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "brick_store.h"
+
+class BrickGrid {
+public:
+    // Cell size follows the average brick size, so a cell holds about one brick
+    void build(BrickStore& store);
+
+    // Call f(begin, end) for each run of store indices that may overlap the box
+    template<class F>
+    void querySpans(float x0, float y0, float x1, float y1, F&& f) const {
+        if(cols == 0) return;
+        // a brick homed left of / below the box can still reach into it
+        int cx0 = cellX(x0 - maxW), cx1 = cellX(x1);
+        int cy0 = cellY(y0 - maxH), cy1 = cellY(y1);
+        for(int cy=cy0; cy<=cy1; cy++) {
+            uint32_t b = cellStart[cy*cols + cx0];
+            uint32_t e = cellStart[cy*cols + cx1 + 1];
+            if(b < e) f(b, e);
+        }
+        if(cellStart.back() < bigEnd) f(cellStart.back(), bigEnd);
+    }
+
+    int columns() const { return cols; }
+    int rows() const { return rowsN; }
+    float cell() const { return cellSize; }
+
+private:
+    int cellX(float x) const { return std::max(0, std::min(cols-1, int((x - originX) * invCell))); }
+    int cellY(float y) const { return std::max(0, std::min(rowsN-1, int((y - originY) * invCell))); }
+
+    float originX = 0, originY = 0;
+    float cellSize = 1, invCell = 1;
+    float maxW = 0, maxH = 0;           // over the bricks homed in cells
+    uint32_t bigEnd = 0;                // oversized bricks: [cellStart.back(), bigEnd)
+    int cols = 0, rowsN = 0;
+    std::vector<uint32_t> cellStart;    // cols*rows + 1 entries into the store
+};
@@ -0,0 +1,291 @@
+// brick_simd.cpp - batched ball-vs-brick narrowphase over a BrickStore
+#include "brick_simd.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DX_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Parameters shared by every lane: the ball path and its inverse direction
+struct SweepParams {
+    float px, py, dx, dy, r;
+    float invDx, invDy;
+};
+
+SweepParams makeParams(float px, float py, float dx, float dy, float r) {
+    SweepParams p = {px, py, dx, dy, r, 0.0f, 0.0f};
+    // a tiny non-zero direction keeps the slab maths finite on axis-aligned paths
+    float sx = (std::fabs(dx) < 1e-8f) ? (dx < 0.0f ? -1e-8f : 1e-8f) : dx;
+    float sy = (std::fabs(dy) < 1e-8f) ? (dy < 0.0f ? -1e-8f : 1e-8f) : dy;
+    p.invDx = 1.0f / sx;
+    p.invDy = 1.0f / sy;
+    return p;
+}
+
+// Lanes at or past `end` must never report
+inline uint32_t laneMask(uint32_t i, uint32_t end, uint32_t lanes) {
+    uint32_t n = end - i;
+    return (1u << std::min(n, lanes)) - 1;
+}
+
+// Exact swept test on the lanes that passed the slab filter
+inline void refine(const BrickStore& s, uint32_t base, uint32_t mask, const SweepParams& p,
+                   SweepHit& best, uint32_t& brick, bool& found) {
+    while(mask) {
+        uint32_t lane = uint32_t(__builtin_ctz(mask));
+        mask &= mask - 1;
+        uint32_t i = base + lane;
+        SweepHit h;
+        if(sweepCircleAABB(p.px, p.py, p.dx, p.dy, p.r, s.x[i], s.y[i], s.w[i], s.h[i], h) &&
+           (!found || h.t < best.t)) {
+            best = h; brick = i; found = true;
+        }
+    }
+}
+
+inline bool slabScalar(const BrickStore& s, uint32_t i, const SweepParams& p) {
+    float tx1 = (s.x[i] - p.r - p.px) * p.invDx;
+    float tx2 = (s.x[i] + s.w[i] + p.r - p.px) * p.invDx;
+    float ty1 = (s.y[i] - p.r - p.py) * p.invDy;
+    float ty2 = (s.y[i] + s.h[i] + p.r - p.py) * p.invDy;
+    float tEnter = std::max(std::min(tx1, tx2), std::min(ty1, ty2));
+    float tExit = std::min(std::max(tx1, tx2), std::max(ty1, ty2));
+    return tEnter <= tExit && tEnter <= 1.0f && tExit >= 0.0f;
+}
+
+bool kernelScalar(const BrickStore& s, uint32_t begin, uint32_t end, const SweepParams& p,
+                  SweepHit& best, uint32_t& brick) {
+    bool found = false;
+    for(uint32_t i=begin; i<end; i++) {
+        if(!s.alive(i) || !slabScalar(s, i, p)) continue;
+        refine(s, i, 1u, p, best, brick, found);
+    }
+    return found;
+}
+
+#ifdef DX_X86_KERNELS
+
+// 4 bricks starting at i -> 4-bit mask of slab hits
+inline uint32_t slabSse(const BrickStore& s, uint32_t i, const SweepParams& p) {
+    __m128 r = _mm_set1_ps(p.r);
+    __m128 px = _mm_set1_ps(p.px), py = _mm_set1_ps(p.py);
+    __m128 ix = _mm_set1_ps(p.invDx), iy = _mm_set1_ps(p.invDy);
+    __m128 x = _mm_loadu_ps(&s.x[i]), y = _mm_loadu_ps(&s.y[i]);
+    __m128 w = _mm_loadu_ps(&s.w[i]), h = _mm_loadu_ps(&s.h[i]);
+    __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(x, r), px), ix);
+    __m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(x, w), r), px), ix);
+    __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(y, r), py), iy);
+    __m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(y, h), r), py), iy);
+    __m128 tEnter = _mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2));
+    __m128 tExit = _mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2));
+    __m128 ok = _mm_and_ps(_mm_cmple_ps(tEnter, tExit),
+                _mm_and_ps(_mm_cmple_ps(tEnter, _mm_set1_ps(1.0f)), _mm_cmpge_ps(tExit, _mm_setzero_ps())));
+    return uint32_t(_mm_movemask_ps(ok));
+}
+
+bool kernelSse2(const BrickStore& s, uint32_t begin, uint32_t end, const SweepParams& p,
+                SweepHit& best, uint32_t& brick) {
+    bool found = false;
+    for(uint32_t i=begin; i<end; i+=8) {
+        uint32_t live = s.aliveRun(i, 8) & laneMask(i, end, 8);
+        if(!live) continue;
+        uint32_t m = slabSse(s, i, p) | (slabSse(s, i + 4, p) << 4);
+        refine(s, i, m & live, p, best, brick, found);
+    }
+    return found;
+}
+
+__attribute__((target("avx2")))
+inline __m256 slabAvx2(const BrickStore& s, uint32_t i, __m256 r, __m256 px, __m256 py,
+                       __m256 ix, __m256 iy, __m256 one, __m256 zero) {
+    __m256 x = _mm256_loadu_ps(&s.x[i]), y = _mm256_loadu_ps(&s.y[i]);
+    __m256 w = _mm256_loadu_ps(&s.w[i]), h = _mm256_loadu_ps(&s.h[i]);
+    __m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(x, r), px), ix);
+    __m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(x, w), r), px), ix);
+    __m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(y, r), py), iy);
+    __m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(y, h), r), py), iy);
+    __m256 tEnter = _mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2));
+    __m256 tExit = _mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2));
+    return _mm256_and_ps(_mm256_cmp_ps(tEnter, tExit, _CMP_LE_OQ),
+           _mm256_and_ps(_mm256_cmp_ps(tEnter, one, _CMP_LE_OQ), _mm256_cmp_ps(tExit, zero, _CMP_GE_OQ)));
+}
+
+__attribute__((target("avx2")))
+bool kernelAvx2(const BrickStore& s, uint32_t begin, uint32_t end, const SweepParams& p,
+                SweepHit& best, uint32_t& brick) {
+    __m256 r = _mm256_set1_ps(p.r);
+    __m256 px = _mm256_set1_ps(p.px), py = _mm256_set1_ps(p.py);
+    __m256 ix = _mm256_set1_ps(p.invDx), iy = _mm256_set1_ps(p.invDy);
+    __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+    bool found = false;
+    for(uint32_t i=begin; i<end; i+=16) {
+        uint32_t live = s.aliveRun(i, 16) & laneMask(i, end, 16);
+        if(!live) continue;
+        uint32_t m = uint32_t(_mm256_movemask_ps(slabAvx2(s, i, r, px, py, ix, iy, one, zero))) |
+                     (uint32_t(_mm256_movemask_ps(slabAvx2(s, i + 8, r, px, py, ix, iy, one, zero))) << 8);
+        refine(s, i, m & live, p, best, brick, found);
+    }
+    return found;
+}
+
+#endif
+
+// ------------------- Q16.16 -------------------
+
+struct SweepParamsFx {
+    fix px, py, dx, dy, r;
+    fix sx0, sy0, sx1, sy1;   // bounds of the swept ball
+};
+
+inline void refineFx(const BrickBoxesFx& b, uint32_t base, uint32_t mask, const SweepParamsFx& p,
+                     SweepHitFx& best, uint32_t& brick, bool& found) {
+    while(mask) {
+        uint32_t lane = uint32_t(__builtin_ctz(mask));
+        mask &= mask - 1;
+        uint32_t i = base + lane;
+        SweepHitFx h;
+        if(sweepCircleAABBFx(p.px, p.py, p.dx, p.dy, p.r, b.x0[i], b.y0[i], b.x1[i] - b.x0[i], b.y1[i] - b.y0[i], h) &&
+           (!found || h.t < best.t)) {
+            best = h; brick = i; found = true;
+        }
+    }
+}
+
+bool kernelScalarFx(const BrickBoxesFx& b, const BrickStore& s, uint32_t begin, uint32_t end,
+                    const SweepParamsFx& p, SweepHitFx& best, uint32_t& brick) {
+    bool found = false;
+    for(uint32_t i=begin; i<end; i++) {
+        if(!s.alive(i) || b.x0[i] > p.sx1 || b.x1[i] < p.sx0 || b.y0[i] > p.sy1 || b.y1[i] < p.sy0) continue;
+        refineFx(b, i, 1u, p, best, brick, found);
+    }
+    return found;
+}
+
+#ifdef DX_X86_KERNELS
+
+// 4 boxes starting at i -> 4-bit mask of boxes inside the swept bounds
+inline uint32_t boundsSse(const BrickBoxesFx& b, uint32_t i, __m128i sx0, __m128i sy0, __m128i sx1, __m128i sy1) {
+    __m128i x0 = _mm_loadu_si128((const __m128i*)&b.x0[i]), x1 = _mm_loadu_si128((const __m128i*)&b.x1[i]);
+    __m128i y0 = _mm_loadu_si128((const __m128i*)&b.y0[i]), y1 = _mm_loadu_si128((const __m128i*)&b.y1[i]);
+    __m128i out = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(x0, sx1), _mm_cmpgt_epi32(sx0, x1)),
+                               _mm_or_si128(_mm_cmpgt_epi32(y0, sy1), _mm_cmpgt_epi32(sy0, y1)));
+    return uint32_t(_mm_movemask_ps(_mm_castsi128_ps(out))) ^ 0xFu;
+}
+
+bool kernelSse2Fx(const BrickBoxesFx& b, const BrickStore& s, uint32_t begin, uint32_t end,
+                  const SweepParamsFx& p, SweepHitFx& best, uint32_t& brick) {
+    __m128i sx0 = _mm_set1_epi32(p.sx0), sy0 = _mm_set1_epi32(p.sy0);
+    __m128i sx1 = _mm_set1_epi32(p.sx1), sy1 = _mm_set1_epi32(p.sy1);
+    bool found = false;
+    for(uint32_t i=begin; i<end; i+=8) {
+        uint32_t live = s.aliveRun(i, 8) & laneMask(i, end, 8);
+        if(!live) continue;
+        uint32_t m = boundsSse(b, i, sx0, sy0, sx1, sy1) | (boundsSse(b, i + 4, sx0, sy0, sx1, sy1) << 4);
+        refineFx(b, i, m & live, p, best, brick, found);
+    }
+    return found;
+}
+
+__attribute__((target("avx2")))
+inline uint32_t boundsAvx2(const BrickBoxesFx& b, uint32_t i, __m256i sx0, __m256i sy0, __m256i sx1, __m256i sy1) {
+    __m256i x0 = _mm256_loadu_si256((const __m256i*)&b.x0[i]), x1 = _mm256_loadu_si256((const __m256i*)&b.x1[i]);
+    __m256i y0 = _mm256_loadu_si256((const __m256i*)&b.y0[i]), y1 = _mm256_loadu_si256((const __m256i*)&b.y1[i]);
+    __m256i out = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(x0, sx1), _mm256_cmpgt_epi32(sx0, x1)),
+                                  _mm256_or_si256(_mm256_cmpgt_epi32(y0, sy1), _mm256_cmpgt_epi32(sy0, y1)));
+    return uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(out))) ^ 0xFFu;
+}
+
+__attribute__((target("avx2")))
+bool kernelAvx2Fx(const BrickBoxesFx& b, const BrickStore& s, uint32_t begin, uint32_t end,
+                  const SweepParamsFx& p, SweepHitFx& best, uint32_t& brick) {
+    __m256i sx0 = _mm256_set1_epi32(p.sx0), sy0 = _mm256_set1_epi32(p.sy0);
+    __m256i sx1 = _mm256_set1_epi32(p.sx1), sy1 = _mm256_set1_epi32(p.sy1);
+    bool found = false;
+    for(uint32_t i=begin; i<end; i+=16) {
+        uint32_t live = s.aliveRun(i, 16) & laneMask(i, end, 16);
+        if(!live) continue;
+        uint32_t m = boundsAvx2(b, i, sx0, sy0, sx1, sy1) | (boundsAvx2(b, i + 8, sx0, sy0, sx1, sy1) << 8);
+        refineFx(b, i, m & live, p, best, brick, found);
+    }
+    return found;
+}
+
+#endif
+
+BrickKernel bestKernel() {
+#ifdef DX_X86_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return BrickKernel::AVX2;
+    if(__builtin_cpu_supports("sse2")) return BrickKernel::SSE2;
+#endif
+    return BrickKernel::SCALAR;
+}
+
+BrickKernel g_kernel = bestKernel();
+
+} // namespace
+
+bool sweepBallBricks(const BrickStore& s, uint32_t begin, uint32_t end,
+                     float px, float py, float dx, float dy, float r,
+                     SweepHit& hit, uint32_t& brick) {
+    if(begin >= end) return false;
+    SweepParams p = makeParams(px, py, dx, dy, r);
+    switch(g_kernel) {
+#ifdef DX_X86_KERNELS
+        case BrickKernel::AVX2: return kernelAvx2(s, begin, end, p, hit, brick);
+        case BrickKernel::SSE2: return kernelSse2(s, begin, end, p, hit, brick);
+#endif
+        default: return kernelScalar(s, begin, end, p, hit, brick);
+    }
+}
+
+void BrickBoxesFx::build(const BrickStore& s) {
+    size_t n = s.x.size();   // includes the dead padding
+    x0.resize(n); y0.resize(n); x1.resize(n); y1.resize(n);
+    for(size_t i=0; i<n; i++) {
+        x0[i] = toFix(s.x[i]); y0[i] = toFix(s.y[i]);
+        x1[i] = x0[i] + toFix(s.w[i]); y1[i] = y0[i] + toFix(s.h[i]);
+    }
+}
+
+bool fitsFixedPoint(const BrickStore& s) {
+    for(uint32_t i=0; i<s.count; i++) {
+        if(!(std::fabs(s.x[i]) <= FIX_MAX_FLOAT && std::fabs(s.y[i]) <= FIX_MAX_FLOAT &&
+             std::fabs(s.x[i] + s.w[i]) <= FIX_MAX_FLOAT && std::fabs(s.y[i] + s.h[i]) <= FIX_MAX_FLOAT)) return false;
+    }
+    return true;
+}
+
+bool sweepBallBricksFx(const BrickBoxesFx& b, const BrickStore& s, uint32_t begin, uint32_t end,
+                       fix px, fix py, fix dx, fix dy, fix r, SweepHitFx& hit, uint32_t& brick) {
+    if(begin >= end) return false;
+    SweepParamsFx p = {px, py, dx, dy, r,
+                       fixMin(px, px + dx) - r, fixMin(py, py + dy) - r,
+                       fixMax(px, px + dx) + r, fixMax(py, py + dy) + r};
+    switch(g_kernel) {
+#ifdef DX_X86_KERNELS
+        case BrickKernel::AVX2: return kernelAvx2Fx(b, s, begin, end, p, hit, brick);
+        case BrickKernel::SSE2: return kernelSse2Fx(b, s, begin, end, p, hit, brick);
+#endif
+        default: return kernelScalarFx(b, s, begin, end, p, hit, brick);
+    }
+}
+
+BrickKernel activeBrickKernel() { return g_kernel; }
+
+void selectBrickKernel(BrickKernel k) {
+    BrickKernel best = bestKernel();
+    g_kernel = (int(k) <= int(best)) ? k : best;
+}
+
+const char* brickKernelName(BrickKernel k) {
+    switch(k) {
+        case BrickKernel::AVX2: return "avx2";
+        case BrickKernel::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,39 @@
+// brick_simd.h - batched ball-vs-brick narrowphase over a BrickStore
+// A vector slab test (ball path vs every brick grown by the radius) rejects
+// 8 or 16 bricks per instruction; the few survivors get the exact swept
+// circle test. The widest kernel the CPU supports is picked at startup.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "brick_store.h"
+#include "collision.h"
+
+enum class BrickKernel { SCALAR, SSE2, AVX2 };
+
+// Earliest contact of the ball (centre px,py, radius r, moving dx,dy) with a
+// live brick in [begin,end). Ties go to the lower brick index.
+bool sweepBallBricks(const BrickStore& s, uint32_t begin, uint32_t end,
+                     float px, float py, float dx, float dy, float r,
+                     SweepHit& hit, uint32_t& brick);
+
+// Brick boxes in Q16.16 as corner columns for PhysicsMode::FIXED, padded
+// like the BrickStore they were built from
+struct BrickBoxesFx {
+    std::vector<fix> x0, y0, x1, y1;
+    void build(const BrickStore& s);
+};
+
+// True if every brick's box fits in a fix, so FIXED can collide with it
+bool fitsFixedPoint(const BrickStore& s);
+
+// The same query in Q16.16: an integer bounds test against the swept ball
+// (8 or 16 lanes at a time, exact, so every kernel agrees) and then the
+// exact integer sweep on the survivors. Alive bits come from `s`.
+bool sweepBallBricksFx(const BrickBoxesFx& b, const BrickStore& s, uint32_t begin, uint32_t end,
+                       fix px, fix py, fix dx, fix dy, fix r, SweepHitFx& hit, uint32_t& brick);
+
+// Kernel in use, and a way to force one (benchmarks); unsupported requests
+// fall back to the best available kernel below them.
+BrickKernel activeBrickKernel();
+void selectBrickKernel(BrickKernel k);
+const char* brickKernelName(BrickKernel k);
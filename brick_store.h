@@ -0,0 +1,108 @@
+// brick_store.h - structure-of-arrays brick storage
+// Collision only touches x/y/w/h and the alive bits, so those live in their
+// own tightly packed arrays; colour is a small palette index looked up only
+// when drawing. Hit points and the brick's id in its level file (kept
+// through the grid's re-ordering) are only read when a brick is hit.
+// Every array runs BRICK_LANES dead, zero-sized bricks past `count`, so a
+// SIMD kernel can load a whole group starting at any live brick.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+
+struct Color { float r,g,b,a; };
+
+static const uint32_t BRICK_LANES = 16;
+
+struct BrickStore {
+    std::vector<float> x, y, w, h;
+    std::vector<uint64_t> aliveBits;
+    std::vector<uint16_t> paletteIndex;
+    std::vector<uint8_t> hp;            // hits left
+    std::vector<uint32_t> id;           // index in the level it came from
+    std::vector<Color> palette;
+    uint32_t count = 0;
+
+    void clear() {
+        x.clear(); y.clear(); w.clear(); h.clear();
+        aliveBits.clear(); paletteIndex.clear(); hp.clear(); id.clear(); palette.clear();
+        count = 0;
+        pad();
+    }
+
+    void reserve(uint32_t n) {
+        x.reserve(n + BRICK_LANES); y.reserve(n + BRICK_LANES);
+        w.reserve(n + BRICK_LANES); h.reserve(n + BRICK_LANES);
+        paletteIndex.reserve(n + BRICK_LANES);
+        hp.reserve(n + BRICK_LANES); id.reserve(n + BRICK_LANES);
+        aliveBits.reserve((n + BRICK_LANES) / 64 + 1);
+    }
+
+    // Palette entries are shared; returns the index of an equal colour if there is one
+    uint16_t addColor(Color c) {
+        for(size_t i=0; i<palette.size(); i++) {
+            const Color& p = palette[i];
+            if(p.r == c.r && p.g == c.g && p.b == c.b && p.a == c.a) return uint16_t(i);
+        }
+        palette.push_back(c);
+        return uint16_t(palette.size() - 1);
+    }
+
+    uint32_t add(float bx, float by, float bw, float bh, uint16_t pal, uint8_t hits = 1) {
+        return add(bx, by, bw, bh, pal, hits, count);
+    }
+    uint32_t add(float bx, float by, float bw, float bh, uint16_t pal, uint8_t hits, uint32_t levelId) {
+        uint32_t i = count++;
+        pad();
+        x[i] = bx; y[i] = by; w[i] = bw; h[i] = bh; paletteIndex[i] = pal;
+        hp[i] = hits; id[i] = levelId;
+        setAlive(i, true);
+        return i;
+    }
+
+    // Bulk append of n live bricks from column arrays (level loading); ids
+    // run from firstId
+    void append(uint32_t n, const float* bx, const float* by, const float* bw, const float* bh,
+                const uint16_t* pal, const uint8_t* hits, uint32_t firstId) {
+        uint32_t base = count;
+        count += n;
+        pad();
+        std::memcpy(&x[base], bx, n * sizeof(float));
+        std::memcpy(&y[base], by, n * sizeof(float));
+        std::memcpy(&w[base], bw, n * sizeof(float));
+        std::memcpy(&h[base], bh, n * sizeof(float));
+        std::memcpy(&paletteIndex[base], pal, n * sizeof(uint16_t));
+        std::memcpy(&hp[base], hits, n);
+        for(uint32_t k=0; k<n; k++) { id[base + k] = firstId + k; setAlive(base + k, true); }
+    }
+
+    bool alive(uint32_t i) const { return (aliveBits[i >> 6] >> (i & 63)) & 1u; }
+    void setAlive(uint32_t i, bool a) {
+        if(a) aliveBits[i >> 6] |= (uint64_t(1) << (i & 63));
+        else  aliveBits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+    // `n` (<= 32) consecutive alive bits starting at brick i
+    uint32_t aliveRun(uint32_t i, uint32_t n) const {
+        uint32_t word = i >> 6, shift = i & 63;
+        uint64_t v = aliveBits[word] >> shift;
+        if(shift + n > 64) v |= aliveBits[word + 1] << (64 - shift);
+        return uint32_t(v & ((uint64_t(1) << n) - 1));
+    }
+
+    const Color& color(uint32_t i) const { return palette[paletteIndex[i]]; }
+
+private:
+    // Keep BRICK_LANES dead, zero-sized bricks past the end (+1 spare alive word)
+    void pad() {
+        size_t padded = count + BRICK_LANES;
+        if(x.size() < padded) {
+            x.resize(padded, 0.0f); y.resize(padded, 0.0f);
+            w.resize(padded, 0.0f); h.resize(padded, 0.0f);
+            paletteIndex.resize(padded, 0);
+            hp.resize(padded, 0); id.resize(padded, 0);
+        }
+        size_t words = padded / 64 + 2;
+        if(aliveBits.size() < words) aliveBits.resize(words, 0);
+    }
+};
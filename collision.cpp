@@ -0,0 +1,178 @@
+// collision.cpp - continuous (swept) ball collision helpers
+#include "collision.h"
+#include <cmath>
+#include <algorithm>
+
+// Moving point vs circle: earliest t in [0,1] where |p + d*t - c| == r
+static bool sweepPointCircle(float px, float py, float dx, float dy,
+                             float cx, float cy, float r, float& t) {
+    float mx = px - cx, my = py - cy;
+    float a = dx*dx + dy*dy;
+    if(a < 1e-12f) return false;
+    float b = mx*dx + my*dy;
+    float c = mx*mx + my*my - r*r;
+    float disc = b*b - a*c;
+    if(disc < 0.0f) return false;
+    t = (-b - std::sqrt(disc)) / a;
+    return t >= 0.0f && t <= 1.0f;
+}
+
+bool sweepCircleAABB(float px, float py, float dx, float dy, float r,
+                     float bx, float by, float bw, float bh, SweepHit& hit) {
+    // Already touching: only report it if we're moving further in
+    float qx = std::min(std::max(px, bx), bx + bw);
+    float qy = std::min(std::max(py, by), by + bh);
+    float ox = px - qx, oy = py - qy;
+    float d2 = ox*ox + oy*oy;
+    if(d2 < r*r) {
+        float nx, ny;
+        if(d2 > 1e-12f) {
+            float inv = 1.0f / std::sqrt(d2);
+            nx = ox * inv; ny = oy * inv;
+        } else {
+            // centre inside the box: push out through the nearest face
+            float left = px - bx, right = bx + bw - px;
+            float bottom = py - by, top = by + bh - py;
+            float m = std::min({left, right, bottom, top});
+            nx = (m == left) ? -1.0f : (m == right) ? 1.0f : 0.0f;
+            ny = (nx != 0.0f) ? 0.0f : (m == bottom) ? -1.0f : 1.0f;
+        }
+        if(dx*nx + dy*ny >= 0.0f) return false;
+        hit.t = 0.0f; hit.nx = nx; hit.ny = ny;
+        return true;
+    }
+
+    // Ray against the box grown by r (slab test), remembering the entry axis
+    float ex0 = bx - r, ex1 = bx + bw + r;
+    float ey0 = by - r, ey1 = by + bh + r;
+    float tEnter = -1e30f, tExit = 1e30f;
+    bool enterX = false;
+    if(std::fabs(dx) < 1e-12f) {
+        if(px < ex0 || px > ex1) return false;
+    } else {
+        float t1 = (ex0 - px) / dx, t2 = (ex1 - px) / dx;
+        if(t1 > t2) std::swap(t1, t2);
+        tEnter = t1; tExit = t2; enterX = true;
+    }
+    if(std::fabs(dy) < 1e-12f) {
+        if(py < ey0 || py > ey1) return false;
+    } else {
+        float t1 = (ey0 - py) / dy, t2 = (ey1 - py) / dy;
+        if(t1 > t2) std::swap(t1, t2);
+        if(t1 > tEnter) { tEnter = t1; enterX = false; }
+        tExit = std::min(tExit, t2);
+    }
+    if(tEnter > tExit || tEnter > 1.0f || tExit < 0.0f) return false;
+
+    // Where on the grown box did we enter? Face regions are flat, the four
+    // corner regions are quarter circles around the real box corners.
+    float te = std::max(tEnter, 0.0f);
+    float hx = px + dx*te, hy = py + dy*te;
+    bool outX = hx < bx || hx > bx + bw;
+    bool outY = hy < by || hy > by + bh;
+    if(outX && outY) {
+        float cx = (hx < bx) ? bx : bx + bw;
+        float cy = (hy < by) ? by : by + bh;
+        float t;
+        if(!sweepPointCircle(px, py, dx, dy, cx, cy, r, t)) return false;
+        hit.t = t;
+        hit.nx = (px + dx*t - cx) / r;
+        hit.ny = (py + dy*t - cy) / r;
+        return true;
+    }
+    hit.t = te;
+    if(enterX) { hit.nx = (dx > 0.0f) ? -1.0f : 1.0f; hit.ny = 0.0f; }
+    else       { hit.nx = 0.0f; hit.ny = (dy > 0.0f) ? -1.0f : 1.0f; }
+    return true;
+}
+
+// ------------------- Q16.16 -------------------
+
+static bool sweepPointCircleFx(fix px, fix py, fix dx, fix dy,
+                               fix cx, fix cy, fix r, fix& t) {
+    int64_t mx = int64_t(px) - cx, my = int64_t(py) - cy;
+    int64_t a = (int64_t(dx)*dx + int64_t(dy)*dy) >> FIX_SHIFT;
+    if(a <= 0) return false;
+    int64_t b = (mx*dx + my*dy) >> FIX_SHIFT;
+    int64_t c = (mx*mx + my*my - int64_t(r)*r) >> FIX_SHIFT;
+    int64_t disc = b*b - a*c;
+    if(disc < 0) return false;
+    int64_t q = ((-b - int64_t(isqrt64(uint64_t(disc)))) * FIX_ONE) / a;
+    if(q < 0 || q > FIX_ONE) return false;
+    t = fix(q);
+    return true;
+}
+
+bool sweepCircleAABBFx(fix px, fix py, fix dx, fix dy, fix r,
+                       fix bx, fix by, fix bw, fix bh, SweepHitFx& hit) {
+    // Integer division is dear: drop boxes outside the swept bounds first
+    if(bx > fixMax(px, px + dx) + r || bx + bw < fixMin(px, px + dx) - r ||
+       by > fixMax(py, py + dy) + r || by + bh < fixMin(py, py + dy) - r) return false;
+    // ...and boxes whose grown outline the path misses (separating axis along
+    // the path normal; every term doubled so centres stay whole)
+    int64_t cx2 = int64_t(bx) * 2 + bw - (int64_t(px) * 2 + dx);
+    int64_t cy2 = int64_t(by) * 2 + bh - (int64_t(py) * 2 + dy);
+    int64_t cross = int64_t(dx) * cy2 - int64_t(dy) * cx2;
+    int64_t reach = (int64_t(bw) + 2 * int64_t(r)) * fixAbs(dy) + (int64_t(bh) + 2 * int64_t(r)) * fixAbs(dx);
+    if((cross < 0 ? -cross : cross) > reach) return false;
+    fix qx = fixMin(fixMax(px, bx), bx + bw);
+    fix qy = fixMin(fixMax(py, by), by + bh);
+    fix ox = px - qx, oy = py - qy;
+    int64_t d2 = int64_t(ox)*ox + int64_t(oy)*oy;
+    if(d2 < int64_t(r)*r) {
+        fix nx, ny;
+        if(d2 > 0) {
+            fix len = fixSqrtWide(d2);
+            nx = fixDiv(ox, len); ny = fixDiv(oy, len);
+        } else {
+            fix left = px - bx, right = bx + bw - px;
+            fix bottom = py - by, top = by + bh - py;
+            fix m = fixMin(fixMin(left, right), fixMin(bottom, top));
+            nx = (m == left) ? -FIX_ONE : (m == right) ? FIX_ONE : 0;
+            ny = (nx != 0) ? 0 : (m == bottom) ? -FIX_ONE : FIX_ONE;
+        }
+        if(int64_t(dx)*nx + int64_t(dy)*ny >= 0) return false;
+        hit.t = 0; hit.nx = nx; hit.ny = ny;
+        return true;
+    }
+
+    fix ex0 = bx - r, ex1 = bx + bw + r;
+    fix ey0 = by - r, ey1 = by + bh + r;
+    fix tEnter = INT32_MIN, tExit = INT32_MAX;
+    bool enterX = false;
+    if(dx == 0) {
+        if(px < ex0 || px > ex1) return false;
+    } else {
+        fix t1 = fixDiv(ex0 - px, dx), t2 = fixDiv(ex1 - px, dx);
+        if(t1 > t2) std::swap(t1, t2);
+        tEnter = t1; tExit = t2; enterX = true;
+    }
+    if(dy == 0) {
+        if(py < ey0 || py > ey1) return false;
+    } else {
+        fix t1 = fixDiv(ey0 - py, dy), t2 = fixDiv(ey1 - py, dy);
+        if(t1 > t2) std::swap(t1, t2);
+        if(t1 > tEnter) { tEnter = t1; enterX = false; }
+        tExit = fixMin(tExit, t2);
+    }
+    if(tEnter > tExit || tEnter > FIX_ONE || tExit < 0) return false;
+
+    fix te = fixMax(tEnter, 0);
+    fix hx = px + fixMul(dx, te), hy = py + fixMul(dy, te);
+    bool outX = hx < bx || hx > bx + bw;
+    bool outY = hy < by || hy > by + bh;
+    if(outX && outY) {
+        fix cx = (hx < bx) ? bx : bx + bw;
+        fix cy = (hy < by) ? by : by + bh;
+        fix t;
+        if(!sweepPointCircleFx(px, py, dx, dy, cx, cy, r, t)) return false;
+        hit.t = t;
+        hit.nx = fixDiv(px + fixMul(dx, t) - cx, r);
+        hit.ny = fixDiv(py + fixMul(dy, t) - cy, r);
+        return true;
+    }
+    hit.t = te;
+    if(enterX) { hit.nx = (dx > 0) ? -FIX_ONE : FIX_ONE; hit.ny = 0; }
+    else       { hit.nx = 0; hit.ny = (dy > 0) ? -FIX_ONE : FIX_ONE; }
+    return true;
+}
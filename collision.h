@@ -0,0 +1,39 @@
+// collision.h - continuous (swept) ball collision helpers
+// The ball is a circle of radius r moving by (dx,dy) over one step. Instead of
+// testing overlap after the move, we find the time of impact t in [0,1] and
+// the surface normal there, so fast balls can't tunnel through thin objects.
+#pragma once
+#include "fixed_point.h"
+
+struct SweepHit {
+    float t;        // fraction of the displacement travelled before contact
+    float nx, ny;   // unit normal of the surface that was hit (points toward the ball)
+};
+
+// Moving circle vs axis-aligned box (x,y = bottom-left corner).
+// Returns false if the circle does not touch the box during the move or is
+// already touching it but moving away.
+bool sweepCircleAABB(float px, float py, float dx, float dy, float r,
+                     float bx, float by, float bw, float bh, SweepHit& hit);
+
+// Reflect velocity (vx,vy) about unit normal (nx,ny)
+inline void reflectVelocity(float& vx, float& vy, float nx, float ny) {
+    float d = vx*nx + vy*ny;
+    vx -= 2.0f * d * nx;
+    vy -= 2.0f * d * ny;
+}
+
+// The same tests in Q16.16 for PhysicsMode::FIXED; identical rules, integer maths
+struct SweepHitFx {
+    fix t;
+    fix nx, ny;
+};
+
+bool sweepCircleAABBFx(fix px, fix py, fix dx, fix dy, fix r,
+                       fix bx, fix by, fix bw, fix bh, SweepHitFx& hit);
+
+inline void reflectVelocityFx(fix& vx, fix& vy, fix nx, fix ny) {
+    fix d = fixMul(vx, nx) + fixMul(vy, ny);
+    vx -= 2 * fixMul(d, nx);
+    vy -= 2 * fixMul(d, ny);
+}
@@ -0,0 +1,83 @@
+// entity_table.h - stable handles over the rows of a dense component table
+// An entity kind (balls, power-ups, ...) keeps each component in its own
+// packed column and removes by swapping the last row into the hole, so a
+// system streams through exactly the columns it reads, rows 0..size()-1,
+// with no holes to skip. Rows move; handles don't. A handle names a slot
+// plus the slot's generation, so it stays valid while other entities come
+// and go and goes stale (find() == NO_ROW) once its own entity is removed.
+// The table only does the bookkeeping; the owner moves its columns.
+#pragma once
+#include <cstdint>
+#include <vector>
+
+struct EntityHandle {
+    uint32_t slot = 0;
+    uint32_t gen = 0;                   // never 0 for a live entity: a default handle is stale
+
+    bool operator==(const EntityHandle& o) const { return slot == o.slot && gen == o.gen; }
+    bool operator!=(const EntityHandle& o) const { return !(*this == o); }
+};
+
+class EntityTable {
+public:
+    static constexpr uint32_t NO_ROW = 0xFFFFFFFFu;
+
+    uint32_t size() const { return uint32_t(owner.size()); }
+
+    void reserve(uint32_t n) { owner.reserve(n); rowOf.reserve(n); gen.reserve(n); freeSlots.reserve(n); }
+
+    // Handle for a new row appended at size(); the owner appends its columns
+    EntityHandle create() {
+        uint32_t slot;
+        if(!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = uint32_t(rowOf.size());
+            rowOf.push_back(NO_ROW);
+            gen.push_back(1);
+        }
+        rowOf[slot] = size();
+        owner.push_back(slot);
+        return {slot, gen[slot]};
+    }
+
+    // Retire the entity in `row`. The last row takes its place: the owner
+    // copies row `last` into `row` (nothing to do when they are equal) and
+    // pops every column. Returns `last`.
+    uint32_t destroy(uint32_t row) {
+        uint32_t last = size() - 1;
+        uint32_t slot = owner[row];
+        retire(slot);
+        if(row != last) {
+            owner[row] = owner[last];
+            rowOf[owner[row]] = row;
+        }
+        owner.pop_back();
+        return last;
+    }
+
+    // Retire every entity; their handles all go stale
+    void clear() {
+        for(uint32_t slot : owner) retire(slot);
+        owner.clear();
+    }
+
+    uint32_t find(EntityHandle h) const {
+        return (h.slot < gen.size() && gen[h.slot] == h.gen) ? rowOf[h.slot] : NO_ROW;
+    }
+    EntityHandle handle(uint32_t row) const { return {owner[row], gen[owner[row]]}; }
+
+    // Plain columns so snapshots can copy them wholesale
+    std::vector<uint32_t> owner;        // row -> slot
+    std::vector<uint32_t> rowOf;        // slot -> row (NO_ROW when free)
+    std::vector<uint32_t> gen;          // slot -> generation
+    std::vector<uint32_t> freeSlots;    // reused last-in first-out
+
+private:
+    void retire(uint32_t slot) {
+        rowOf[slot] = NO_ROW;
+        if(++gen[slot] == 0) gen[slot] = 1;
+        freeSlots.push_back(slot);
+    }
+};
@@ -0,0 +1,62 @@
+// fixed_point.h - Q16.16 arithmetic for the deterministic physics mode
+// Every operation is plain integer maths, so results are bit-identical on
+// any two's-complement machine regardless of compiler flags, FMA contraction
+// or libm. Products and quotients go through 64-bit intermediates.
+// Converting from float truncates and saturates at +-FIX_MAX_FLOAT; back to
+// float rounds once |v| > 256. Neither is exact, but both are deterministic:
+// the same bits give the same result on every CPU.
+#pragma once
+#include <cstdint>
+
+typedef int32_t fix;
+
+static const int FIX_SHIFT = 16;
+static const fix FIX_ONE = fix(1) << FIX_SHIFT;
+static const fix FIX_HALF = FIX_ONE / 2;
+
+// Largest magnitude toFix() keeps; levels reaching past it can't run FIXED
+static const float FIX_MAX_FLOAT = 32767.99f;
+
+// Clamped first: an out-of-range float-to-int cast is undefined, and x86 and
+// ARM really do disagree on it. NaN becomes 0.
+inline fix toFix(float v) {
+    if(!(v == v)) return 0;
+    v = v < -FIX_MAX_FLOAT ? -FIX_MAX_FLOAT : (v > FIX_MAX_FLOAT ? FIX_MAX_FLOAT : v);
+    return fix(v * 65536.0f);
+}
+inline fix toFix(int v) { return fix(v) * FIX_ONE; }
+inline float fixToFloat(fix v) { return float(v) * (1.0f / 65536.0f); }
+
+inline fix fixMul(fix a, fix b) { return fix((int64_t(a) * b) >> FIX_SHIFT); }
+
+// Saturates instead of overflowing; b must not be 0
+inline fix fixDiv(fix a, fix b) {
+    int64_t q = (int64_t(a) * FIX_ONE) / b;
+    if(q > INT32_MAX) return INT32_MAX;
+    if(q < INT32_MIN) return INT32_MIN;
+    return fix(q);
+}
+
+inline fix fixAbs(fix v) { return v < 0 ? -v : v; }
+inline fix fixMin(fix a, fix b) { return a < b ? a : b; }
+inline fix fixMax(fix a, fix b) { return a > b ? a : b; }
+inline fix fixClamp(fix v, fix lo, fix hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+// floor(sqrt(v)), bit by bit
+inline uint64_t isqrt64(uint64_t v) {
+    uint64_t root = 0, bit = uint64_t(1) << 62;
+    while(bit > v) bit >>= 2;
+    while(bit) {
+        if(v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// sqrt of a Q32.32 quantity (the product of two fixes) as a fix
+inline fix fixSqrtWide(int64_t q32) { return q32 <= 0 ? 0 : fix(isqrt64(uint64_t(q32))); }
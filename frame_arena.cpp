@@ -0,0 +1,95 @@
+// frame_arena.cpp - per-frame bump allocator and the heap allocation hook
+#include "frame_arena.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ------------------- Allocation hook -------------------
+
+static thread_local uint64_t t_heapAllocs = 0;
+
+// The profiler's global count costs one load while it is off
+void* operator new(std::size_t n) {
+    t_heapAllocs++;
+    if(g_profilerOn.load(std::memory_order_relaxed)) g_heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+uint64_t threadHeapAllocs() { return t_heapAllocs; }
+
+uint64_t AllocWatch::endFrame(bool unsettled, const char* what) {
+    uint64_t now = t_heapAllocs;
+    uint64_t n = now - last;
+    last = now;
+    if(unsettled) {
+        quiet = 0;
+        return 0;
+    }
+    if(quiet < warmup) {
+        quiet++;
+        return 0;
+    }
+    if(n) {
+        badFrames++;
+        std::fprintf(stderr, "%llu heap allocation(s) in a steady %s frame\n", (unsigned long long)n, what);
+        if(fatal) std::abort();
+    }
+    return n;
+}
+
+// ------------------- FrameArena -------------------
+
+FrameArena::FrameArena(size_t bytes) : block(bytes) {}
+
+void* FrameArena::alloc(size_t n, size_t align) {
+    size_t at = (top + align - 1) & ~(align - 1);
+    if(at + n <= block.size()) {
+        top = at + n;
+        return block.data() + at;
+    }
+    // over budget this frame: a heap chunk (operator new[] is max_align_t aligned)
+    spill.emplace_back(new char[n ? n : 1]);
+    spilled += n;
+    return spill.back().get();
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args, again;
+    va_start(args, fmt);
+    va_copy(again, args);
+    size_t room = block.size() - std::min(block.size(), top);
+    char* out = block.data() + top;
+    int len = std::vsnprintf(out, room, fmt, args);
+    va_end(args);
+    if(len < 0) {
+        va_end(again);
+        return "";
+    }
+    if(size_t(len) < room) {
+        top += size_t(len) + 1;
+    } else {
+        out = static_cast<char*>(alloc(size_t(len) + 1, 1));
+        std::vsnprintf(out, size_t(len) + 1, fmt, again);
+    }
+    va_end(again);
+    return out;
+}
+
+void FrameArena::reset() {
+    peakBytes = std::max(peakBytes, used());
+    if(!spill.empty()) {
+        block.resize(std::max(block.size() * 2, peakBytes + peakBytes / 2));
+        spill.clear();
+    }
+    top = 0;
+    spilled = 0;
+}
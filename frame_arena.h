@@ -0,0 +1,64 @@
+// frame_arena.h - per-frame bump allocator for transient strings and buffers
+// Everything taken from the arena during a frame is dropped at once by
+// reset() at the start of the next one, so formatting a HUD line or a menu
+// entry costs a pointer bump instead of a heap allocation. A frame that
+// needs more than the block spills into heap chunks; the next reset() grows
+// the block to that frame's peak, so the spill happens once.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FrameArena {
+public:
+    explicit FrameArena(size_t bytes = 64 * 1024);
+
+    // Uninitialised storage, valid until the next reset()
+    void* alloc(size_t n, size_t align = alignof(std::max_align_t));
+    template<class T>
+    T* allocArray(size_t n) { return static_cast<T*>(alloc(n * sizeof(T), alignof(T))); }
+    // printf into the arena
+    const char* format(const char* fmt, ...)
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    void reset();
+
+    size_t used() const { return top + spilled; }
+    size_t peak() const { return peakBytes; }
+    size_t capacity() const { return block.size(); }
+
+private:
+    std::vector<char> block;
+    size_t top = 0;
+    size_t spilled = 0;                            // bytes in `spill` this frame
+    size_t peakBytes = 0;
+    std::vector<std::unique_ptr<char[]>> spill;
+};
+
+// Heap allocations (operator new) made by the calling thread so far.
+// Always counted: one thread-local increment per allocation.
+uint64_t threadHeapAllocs();
+
+// Flags frames that still allocate once the front-end has settled. A frame
+// is steady after `warmup` frames without anything marked unsettled (a
+// screen change, a new round, typing); caches and buffers may grow while
+// warming up. Counts the calling thread only.
+class AllocWatch {
+public:
+    uint32_t warmup = 120;
+    bool fatal = false;                            // abort on the first violation
+
+    // Call once per frame on the main thread. Returns the allocations made
+    // since the previous call if the frame was steady, 0 otherwise.
+    uint64_t endFrame(bool unsettled, const char* what);
+    uint64_t violations() const { return badFrames; }
+
+private:
+    uint64_t last = 0;
+    uint32_t quiet = 0;
+    uint64_t badFrames = 0;
+};
@@ -0,0 +1,527 @@
+// game_world.cpp - headless DX Ball simulation core
+#include "game_world.h"
+#include "collision.h"
+#include "brick_simd.h"
+#include <cmath>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+GameWorld::GameWorld(uint64_t seed) {
+    rng.seed(seed);
+    events.reserve(16);
+}
+
+bool checkCollision(float ax, float ay, float aw, float ah, float bx, float by, float bw, float bh) {
+    return ax < bx+bw && ax+aw > bx && ay < by+bh && ay+ah > by;
+}
+
+void GameWorld::resetBallOnPaddle() {
+    balls.clear();
+    powerUps.clear();
+    balls.add(padX + padW/2.0f, padY + padH + 18.0f,
+              BALL_SPEED_X * ((rng.next() & 1) ? 1 : -1), BALL_SPEED_Y, ballSize);
+    ballStuckToPaddle = true;
+    snapPrevious();
+}
+
+// cos/sin(SPLIT_ANGLE) in Q16.16: the fixed path never calls libm
+static const fix SPLIT_COS_FX = 61563, SPLIT_SIN_FX = 22472;
+
+void GameWorld::splitBalls() {
+    float c = std::cos(SPLIT_ANGLE), s = std::sin(SPLIT_ANGLE);
+    uint32_t n = balls.count;
+    for(uint32_t i=0; i<n && balls.count + 2 <= maxBalls; i++) {
+        float vx = balls.vx[i], vy = balls.vy[i];
+        float x = balls.x[i], y = balls.y[i], r = balls.r[i];
+        if(physics == PhysicsMode::FIXED) {
+            fix fvx = toFix(vx), fvy = toFix(vy);
+            fix xc = fixMul(fvx, SPLIT_COS_FX), xs = fixMul(fvx, SPLIT_SIN_FX);
+            fix yc = fixMul(fvy, SPLIT_COS_FX), ys = fixMul(fvy, SPLIT_SIN_FX);
+            balls.add(x, y, fixToFloat(xc - ys), fixToFloat(xs + yc), r);
+            balls.add(x, y, fixToFloat(xc + ys), fixToFloat(yc - xs), r);
+            continue;
+        }
+        balls.add(x, y, vx*c - vy*s, vx*s + vy*c, r);
+        balls.add(x, y, vx*c + vy*s, -vx*s + vy*c, r);
+    }
+}
+
+void makeGridLevel(int rows, int cols, BrickStore& out) {
+    out.clear();
+    float marginX = 80, marginY = 100;
+    float gapX = (cols > 16) ? 1.0f : 10.0f, gapY = (rows > 8) ? 1.0f : 8.0f;
+    float bw = (WIN_W - 2*marginX - (cols-1)*gapX) / cols;
+    float bh = std::min(35.0f, WIN_H * 0.55f / rows - gapY);
+    out.reserve(uint32_t(rows * cols));
+
+    for(int r=0;r<rows;r++){
+        for(int c=0;c<cols;c++){
+            float x = marginX + c*(bw+gapX);
+            float y = WIN_H - marginY - (r+1)*(bh+gapY);
+            // colours repeat every 4x8 bricks so big levels keep a small palette
+            int pr = r % 4, pc = c % 8;
+            float fr = 0.15f + 0.7f * (float(pc) / 7.0f);
+            float fg = 0.15f + 0.6f * (float((pr + pc) % 8) / 7.0f);
+            float fb = 0.35f + 0.5f * (float(pr) / 3.0f);
+            out.add(x, y, bw, bh, out.addColor({fr, fg, fb, 1.0f}));
+        }
+    }
+}
+
+void GameWorld::resetLevel(int rows, int cols) {
+    BrickStore level;
+    makeGridLevel(rows, cols, level);
+    BrickGrid g;
+    g.build(level);
+    loadLevel(std::move(level), std::move(g));
+}
+
+void GameWorld::loadLevel(BrickStore&& level, BrickGrid&& g, uint32_t notResident) {
+    replaceBricks(std::move(level), std::move(g), notResident);
+    startRound();
+}
+
+void GameWorld::loadLevel(PreparedLevel&& level) {
+    uint32_t notResident = level.notResident();
+    loadLevel(std::move(level.bricks), std::move(level.grid), notResident);
+    if(level.streamed) {
+        stream = std::move(level.stream);
+        streamFile = std::move(level.file);
+        streaming = true;
+    }
+}
+
+void GameWorld::resetLevel(const BrickStore& level, const BrickGrid& g) {
+    bricks = level;
+    grid = g;
+    bricksNotResident = 0;
+    rebuildBrickIndex();
+    startRound();
+}
+
+void GameWorld::startRound() {
+    streaming = false;
+    streamFile.reset();
+    scrollY = 0.0f;
+    levelFloor = float(WIN_H);
+    for(uint32_t i : aliveBricks) levelFloor = std::min(levelFloor, bricks.y[i]);
+    score = 0;
+    lives = 3;
+    round = RoundState::RUNNING;
+    events.clear();
+    resetBallOnPaddle();
+}
+
+void GameWorld::replaceBricks(BrickStore&& level, BrickGrid&& g, uint32_t notResident) {
+    bricks = std::move(level);
+    grid = std::move(g);
+    bricksNotResident = notResident;
+    rebuildBrickIndex();
+}
+
+void GameWorld::rebuildBrickIndex() {
+    aliveBricks.clear();
+    aliveSlot.assign(bricks.count, 0u);
+    bricksOnScreen = 0;
+    brickBoxFx.build(bricks);
+    for(uint32_t i=0; i<bricks.count; i++) {
+        if(!bricks.alive(i)) continue;
+        if(bricks.y[i] < WIN_H) bricksOnScreen++;
+        aliveSlot[i] = uint32_t(aliveBricks.size());
+        aliveBricks.push_back(i);
+    }
+}
+
+void GameWorld::killBrick(uint32_t i) {
+    if(!bricks.alive(i)) return;
+    bricks.setAlive(i, false);
+    if(bricks.y[i] < WIN_H) bricksOnScreen--;
+    // swap-remove from the alive list
+    uint32_t slot = aliveSlot[i];
+    uint32_t last = aliveBricks.back();
+    aliveBricks[slot] = last;
+    aliveSlot[last] = slot;
+    aliveBricks.pop_back();
+}
+
+void GameWorld::clampPaddle() {
+    if(padX < 10) padX = 10;
+    if(padX > WIN_W - padW - 10) padX = WIN_W - padW - 10;
+}
+
+void GameWorld::applyInput(const GameInput& in) {
+    if(in.hasPadTarget) {
+        padX = in.padTarget - padW/2;
+        clampPaddle();
+    }
+    if(in.padMove != 0.0f) {
+        padX += in.padMove;
+        clampPaddle();
+    }
+    if(in.launch) ballStuckToPaddle = false;
+}
+
+void GameWorld::step(const GameInput& in, float dt) {
+    events.clear();
+    snapPrevious();
+    if(round != RoundState::RUNNING) return;
+    applyInput(in);
+    updateBalls(dt);
+    updatePowerUps(dt);
+}
+
+// How many surfaces the ball may bounce off within one step
+static const int MAX_CONTACTS_PER_STEP = 8;
+// Distance the ball is pushed off a surface after contact, so it doesn't re-hit it
+static const float CONTACT_SKIN = 0.01f;
+
+enum HitKind { HIT_NONE, HIT_WALL, HIT_PADDLE, HIT_BRICK };
+
+void GameWorld::updateBalls(float dt) {
+    if(ballStuckToPaddle) {
+        balls.x[0] = padX + padW/2.0f;
+        return;
+    }
+
+    claims.clear();
+    lostBalls.clear();
+    bool fixed = physics == PhysicsMode::FIXED;
+    for(uint32_t i=0; i<balls.count; i++) {
+        if(!(fixed ? moveBallFixed(i, dt) : moveBall(i, dt))) lostBalls.push_back(i);
+    }
+    resolveBrickClaims();
+
+    // Highest index first, so swap-removal never moves a ball still to be removed
+    for(size_t k=lostBalls.size(); k-- > 0; ) balls.remove(lostBalls[k]);
+
+    // Bottom boundary: the life is lost with the last ball
+    if(balls.count == 0) {
+        lives--;
+        emit(SimEventType::LOSE_LIFE, padX + padW/2.0f, 0.0f);
+        if(lives > 0) {
+            resetBallOnPaddle();
+        } else {
+            round = RoundState::LOST;
+            emit(SimEventType::GAME_OVER, padX + padW/2.0f, 0.0f);
+        }
+    }
+
+    // Nothing left to hit on screen, but the level goes on above
+    if(round == RoundState::RUNNING && bricksOnScreen == 0 && (!aliveBricks.empty() || bricksNotResident > 0)) {
+        scrollLevel();
+    }
+
+    // Check win condition
+    if(aliveBricks.empty() && bricksNotResident == 0) {
+        round = RoundState::CLEARED;
+        emit(SimEventType::WIN, WIN_W/2.0f, WIN_H/2.0f);
+    }
+}
+
+// Scroll so the lowest live brick lands where the level's lowest brick
+// started, page the stream's window to match and serve again. Positions
+// move by a float subtraction on every brick, the same on every replay.
+void GameWorld::scrollLevel() {
+    float next = 0.0f;
+    bool any = false;
+    for(uint32_t i : aliveBricks) {
+        float y = bricks.y[i] + scrollY;
+        if(!any || y < next) next = y;
+        any = true;
+    }
+    float y;
+    if(streaming && stream.lowestOutside(y) && (!any || y < next)) {
+        next = y;
+        any = true;
+    }
+    if(!any) return;
+
+    float to = next - levelFloor;
+    float shift = to - scrollY;             // resident bricks are in screen coordinates
+    if(streaming) {
+        BrickStore paged;
+        if(stream.setWindow(to, to + WIN_H, &bricks, paged)) {
+            bricks = std::move(paged);
+            shift = to;                         // freshly paged bricks are in level coordinates
+        }
+        bricksNotResident = stream.notResident();
+    }
+    for(uint32_t i=0; i<bricks.count; i++) bricks.y[i] -= shift;
+    scrollY = to;
+    grid.build(bricks);
+    rebuildBrickIndex();
+    resetBallOnPaddle();
+    emit(SimEventType::SCROLL, WIN_W/2.0f, WIN_H/2.0f);
+}
+
+bool GameWorld::moveBall(uint32_t b, float dt) {
+    float ballX = balls.x[b], ballY = balls.y[b];
+    float ballVX = balls.vx[b], ballVY = balls.vy[b];
+    const float r = balls.r[b];
+    ownHits.clear();
+
+    // Move along the step, stopping at each contact in time order and
+    // continuing with the reflected velocity for whatever time is left.
+    float remaining = 1.0f;
+    for(int iter=0; iter<MAX_CONTACTS_PER_STEP && remaining > 0.0f; iter++) {
+        float dx = ballVX * dt * remaining;
+        float dy = ballVY * dt * remaining;
+
+        SweepHit best = {2.0f, 0.0f, 0.0f};
+        HitKind kind = HIT_NONE;
+        uint32_t hitBlock = 0;
+
+        // Walls (left/right/top, and the floor when it bounces) are planes
+        if(dx < 0.0f && ballX + dx - r < 0.0f) {
+            float t = std::max(0.0f, (r - ballX) / dx);
+            if(t < best.t) { best = {t, 1.0f, 0.0f}; kind = HIT_WALL; }
+        }
+        if(dx > 0.0f && ballX + dx + r > WIN_W) {
+            float t = std::max(0.0f, (WIN_W - r - ballX) / dx);
+            if(t < best.t) { best = {t, -1.0f, 0.0f}; kind = HIT_WALL; }
+        }
+        if(dy > 0.0f && ballY + dy + r > WIN_H) {
+            float t = std::max(0.0f, (WIN_H - r - ballY) / dy);
+            if(t < best.t) { best = {t, 0.0f, -1.0f}; kind = HIT_WALL; }
+        }
+        if(floorBounces && dy < 0.0f && ballY + dy - r < 0.0f) {
+            float t = std::max(0.0f, (r - ballY) / dy);
+            if(t < best.t) { best = {t, 0.0f, 1.0f}; kind = HIT_WALL; }
+        }
+
+        SweepHit h;
+        if(sweepCircleAABB(ballX, ballY, dx, dy, r, padX, padY, padW, padH, h) && h.t < best.t) {
+            best = h; kind = HIT_PADDLE;
+        }
+
+        // Bricks: batched narrowphase over the grid rows covered by the swept box
+        float sx0 = std::min(ballX, ballX + dx) - r, sx1 = std::max(ballX, ballX + dx) + r;
+        float sy0 = std::min(ballY, ballY + dy) - r, sy1 = std::max(ballY, ballY + dy) + r;
+        grid.querySpans(sx0, sy0, sx1, sy1, [&](uint32_t begin, uint32_t end) {
+            uint32_t i;
+            if(sweepBallBricks(bricks, begin, end, ballX, ballY, dx, dy, r, h, i) && h.t < best.t) {
+                best = h; kind = HIT_BRICK; hitBlock = i;
+            }
+        });
+
+        if(kind == HIT_NONE) {
+            ballX += dx;
+            ballY += dy;
+            break;
+        }
+
+        ballX += dx * best.t + best.nx * CONTACT_SKIN;
+        ballY += dy * best.t + best.ny * CONTACT_SKIN;
+        float tickT = 1.0f - remaining * (1.0f - best.t);
+        remaining *= (1.0f - best.t);
+
+        if(kind == HIT_PADDLE && ballY > padY) {
+            // Anything above the paddle's bottom edge bounces up, angled by where it landed
+            float hit = (ballX - (padX + padW/2)) / (padW/2);
+            ballVX = std::max(-1.0f, std::min(1.0f, hit)) * paddleDeflect;
+            ballVY = BALL_SPEED_Y;
+            // paddle moved onto the ball: nudge it above the paddle
+            if(ballY < padY + padH + r) ballY = padY + padH + r + 1.0f;
+            emit(SimEventType::PADDLE_HIT, ballX, ballY);
+            continue;
+        }
+
+        reflectVelocity(ballVX, ballVY, best.nx, best.ny);
+        if(kind == HIT_BRICK) {
+            // Hidden from this ball for the rest of the step; it dies in resolveBrickClaims()
+            bricks.setAlive(hitBlock, false);
+            ownHits.push_back(hitBlock);
+            claims.push_back({hitBlock, tickT, b, ballX, ballY});
+            // a corner bounce can flatten the path; never let the ball crawl sideways forever
+            float minVY = 0.25f * BALL_SPEED_Y;
+            if(std::fabs(ballVY) < minVY) ballVY = (ballVY < 0.0f) ? -minVY : minVY;
+        }
+    }
+    for(uint32_t i : ownHits) bricks.setAlive(i, true);
+
+    balls.x[b] = ballX; balls.y[b] = ballY;
+    balls.vx[b] = ballVX; balls.vy[b] = ballVY;
+    return ballY - r >= 0;
+}
+
+// moveBall() in Q16.16. Same contact rules, same order of tests and the
+// same tie-breaks; only the number format differs.
+bool GameWorld::moveBallFixed(uint32_t b, float dt) {
+    fix ballX = toFix(balls.x[b]), ballY = toFix(balls.y[b]);
+    fix ballVX = toFix(balls.vx[b]), ballVY = toFix(balls.vy[b]);
+    const fix r = toFix(balls.r[b]);
+    const fix step = toFix(dt);
+    const fix pX = toFix(padX), pY = toFix(padY), pW = toFix(padW), pH = toFix(padH);
+    const fix winW = toFix(WIN_W), winH = toFix(WIN_H);
+    const fix skin = toFix(CONTACT_SKIN);
+    ownHits.clear();
+
+    fix remaining = FIX_ONE;
+    for(int iter=0; iter<MAX_CONTACTS_PER_STEP && remaining > 0; iter++) {
+        fix dx = fixMul(fixMul(ballVX, step), remaining);
+        fix dy = fixMul(fixMul(ballVY, step), remaining);
+
+        SweepHitFx best = {2 * FIX_ONE, 0, 0};
+        HitKind kind = HIT_NONE;
+        uint32_t hitBlock = 0;
+
+        if(dx < 0 && ballX + dx - r < 0) {
+            fix t = fixMax(0, fixDiv(r - ballX, dx));
+            if(t < best.t) { best = {t, FIX_ONE, 0}; kind = HIT_WALL; }
+        }
+        if(dx > 0 && ballX + dx + r > winW) {
+            fix t = fixMax(0, fixDiv(winW - r - ballX, dx));
+            if(t < best.t) { best = {t, -FIX_ONE, 0}; kind = HIT_WALL; }
+        }
+        if(dy > 0 && ballY + dy + r > winH) {
+            fix t = fixMax(0, fixDiv(winH - r - ballY, dy));
+            if(t < best.t) { best = {t, 0, -FIX_ONE}; kind = HIT_WALL; }
+        }
+        if(floorBounces && dy < 0 && ballY + dy - r < 0) {
+            fix t = fixMax(0, fixDiv(r - ballY, dy));
+            if(t < best.t) { best = {t, 0, FIX_ONE}; kind = HIT_WALL; }
+        }
+
+        SweepHitFx h;
+        if(sweepCircleAABBFx(ballX, ballY, dx, dy, r, pX, pY, pW, pH, h) && h.t < best.t) {
+            best = h; kind = HIT_PADDLE;
+        }
+
+        fix sx0 = fixMin(ballX, ballX + dx) - r, sx1 = fixMax(ballX, ballX + dx) + r;
+        fix sy0 = fixMin(ballY, ballY + dy) - r, sy1 = fixMax(ballY, ballY + dy) + r;
+        grid.querySpans(fixToFloat(sx0), fixToFloat(sy0), fixToFloat(sx1), fixToFloat(sy1), [&](uint32_t begin, uint32_t end) {
+            uint32_t i;
+            if(sweepBallBricksFx(brickBoxFx, bricks, begin, end, ballX, ballY, dx, dy, r, h, i) && h.t < best.t) {
+                best = h; kind = HIT_BRICK; hitBlock = i;
+            }
+        });
+
+        if(kind == HIT_NONE) {
+            ballX += dx;
+            ballY += dy;
+            break;
+        }
+
+        ballX += fixMul(dx, best.t) + fixMul(best.nx, skin);
+        ballY += fixMul(dy, best.t) + fixMul(best.ny, skin);
+        fix tickT = FIX_ONE - fixMul(remaining, FIX_ONE - best.t);
+        remaining = fixMul(remaining, FIX_ONE - best.t);
+
+        if(kind == HIT_PADDLE && ballY > pY) {
+            fix half = pW / 2;
+            fix hit = fixDiv(ballX - (pX + half), half);
+            ballVX = fixMul(fixClamp(hit, -FIX_ONE, FIX_ONE), toFix(paddleDeflect));
+            ballVY = toFix(BALL_SPEED_Y);
+            if(ballY < pY + pH + r) ballY = pY + pH + r + FIX_ONE;
+            emit(SimEventType::PADDLE_HIT, fixToFloat(ballX), fixToFloat(ballY));
+            continue;
+        }
+
+        reflectVelocityFx(ballVX, ballVY, best.nx, best.ny);
+        if(kind == HIT_BRICK) {
+            bricks.setAlive(hitBlock, false);
+            ownHits.push_back(hitBlock);
+            claims.push_back({hitBlock, fixToFloat(tickT), b, fixToFloat(ballX), fixToFloat(ballY)});
+            fix minVY = toFix(BALL_SPEED_Y) / 4;
+            if(fixAbs(ballVY) < minVY) ballVY = (ballVY < 0) ? -minVY : minVY;
+        }
+    }
+    for(uint32_t i : ownHits) bricks.setAlive(i, true);
+
+    balls.x[b] = fixToFloat(ballX); balls.y[b] = fixToFloat(ballY);
+    balls.vx[b] = fixToFloat(ballVX); balls.vy[b] = fixToFloat(ballVY);
+    return ballY - r >= 0;
+}
+
+void GameWorld::resolveBrickClaims() {
+    if(claims.empty()) return;
+    // Every ball that reached a brick takes one hit point off it (and has
+    // already bounced); the earliest impact, ball index breaking ties, is where
+    // the event is reported. Results go out in brick order.
+    std::sort(claims.begin(), claims.end(), [](const BrickClaim& a, const BrickClaim& b) {
+        if(a.brick != b.brick) return a.brick < b.brick;
+        if(a.t != b.t) return a.t < b.t;
+        return a.ball < b.ball;
+    });
+    for(size_t k=0; k<claims.size(); ) {
+        const BrickClaim& c = claims[k];
+        size_t hits = 1;
+        while(k + hits < claims.size() && claims[k + hits].brick == c.brick) hits++;
+        k += hits;
+        uint8_t& hp = bricks.hp[c.brick];
+        if(hp > hits) {
+            hp = uint8_t(hp - hits);
+            emit(SimEventType::BRICK_DAMAGED, c.x, c.y, c.brick);
+            continue;
+        }
+        hp = 0;
+        killBrick(c.brick);
+        score += 10;
+        emit(SimEventType::BRICK_HIT, c.x, c.y, c.brick);
+        if(powerUpChance > 0.0f && rng.nextFloat() < powerUpChance) {
+            powerUps.add(bricks.x[c.brick] + (bricks.w[c.brick] - POWERUP_W) * 0.5f,
+                         bricks.y[c.brick], PowerUpType::MULTI_BALL);
+        }
+    }
+}
+
+// Caught by the paddle or below the floor: either way it leaves the pool.
+// checkCollision() without the short-circuits, which mispredict on capsules
+// in no particular order.
+static inline bool powerUpLeaves(float x, float y, float padX0, float padY0, float padX1, float padY1) {
+    bool caught = (x < padX1) & (x + POWERUP_W > padX0) & (y < padY1) & (y + POWERUP_H > padY0);
+    return caught | !(y + POWERUP_H >= 0.0f);
+}
+
+// Number of capsules from k on that stay in the pool, stopping at the first
+// one that leaves. Same comparisons as powerUpLeaves(), four lanes at a time.
+static uint32_t powerUpSurvivors(const float* x, const float* y, uint32_t k, uint32_t n,
+                                 float padX0, float padY0, float padX1, float padY1) {
+    uint32_t start = k;
+#ifdef __SSE2__
+    const __m128 x0 = _mm_set1_ps(padX0), y0 = _mm_set1_ps(padY0);
+    const __m128 x1 = _mm_set1_ps(padX1), y1 = _mm_set1_ps(padY1);
+    const __m128 w = _mm_set1_ps(POWERUP_W), h = _mm_set1_ps(POWERUP_H), zero = _mm_setzero_ps();
+    for(; k + 4 <= n; k += 4) {
+        __m128 px = _mm_loadu_ps(&x[k]), py = _mm_loadu_ps(&y[k]);
+        __m128 top = _mm_add_ps(py, h);
+        __m128 caught = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(px, x1), _mm_cmpgt_ps(_mm_add_ps(px, w), x0)),
+                                   _mm_and_ps(_mm_cmplt_ps(py, y1), _mm_cmpgt_ps(top, y0)));
+        if(_mm_movemask_ps(_mm_or_ps(caught, _mm_cmpnge_ps(top, zero)))) break;
+    }
+#endif
+    while(k < n && !powerUpLeaves(x[k], y[k], padX0, padY0, padX1, padY1)) k++;
+    return k - start;
+}
+
+void GameWorld::updatePowerUps(float dt) {
+    if(round != RoundState::RUNNING || powerUps.count == 0) return;
+    // Fall: a straight pass over the y column
+    float* y = powerUps.y.data();
+    uint32_t n = powerUps.count;
+    if(physics == PhysicsMode::FIXED) {
+        fix fall = fixMul(toFix(POWERUP_FALL_SPEED), toFix(dt));
+        for(uint32_t k=0; k<n; k++) y[k] = fixToFloat(toFix(y[k]) - fall);
+    } else {
+        float fall = POWERUP_FALL_SPEED * dt;
+        for(uint32_t k=0; k<n; k++) y[k] -= fall;
+    }
+    // Caught or gone: the capsule swapped into slot k is tested next
+    const float padX0 = padX, padY0 = padY, padX1 = padX + padW, padY1 = padY + padH;
+    for(uint32_t k=0; ; ) {
+        const float* x = powerUps.x.data();
+        y = powerUps.y.data();
+        n = powerUps.count;
+        k += powerUpSurvivors(x, y, k, n, padX0, padY0, padX1, padY1);
+        if(k == n) break;
+        float px = x[k], py = y[k];
+        if(py + POWERUP_H >= 0.0f) {
+            emit(SimEventType::POWERUP, px + POWERUP_W * 0.5f, py + POWERUP_H * 0.5f);
+            if(powerUps.type[k] == PowerUpType::MULTI_BALL && !ballStuckToPaddle) splitBalls();
+        }
+        powerUps.remove(k);
+    }
+}
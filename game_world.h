@@ -0,0 +1,196 @@
+// game_world.h - headless DX Ball simulation core
+// No GL, no GLUT, no sound: everything the round needs lives in GameWorld and
+// advances through step(). The front-end (main.cpp) feeds input in and reacts
+// to the events that come out.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "brick_store.h"
+#include "brick_grid.h"
+#include "ball_pool.h"
+#include "power_ups.h"
+#include "brick_simd.h"
+#include "level.h"
+
+static const int WIN_W = 900;
+static const int WIN_H = 700;
+
+// Speeds are in pixels per second; the old per-tick values assumed a 16 ms tick
+static const float BALL_SPEED_X   = 500.0f;
+static const float BALL_SPEED_Y   = 625.0f;
+static const float PADDLE_DEFLECT = 750.0f;   // horizontal speed at the paddle edge
+static const float DEFAULT_SIM_HZ = 120.0f;
+static const float POWERUP_FALL_SPEED = 180.0f;
+static const float POWERUP_W = 36.0f, POWERUP_H = 14.0f;
+static const float SPLIT_ANGLE = 0.35f;       // radians between a split ball and its copies
+// GameWorld::padSpeed is in pixels per keyboard auto-repeat event (the
+// original control); held keys move the paddle at padSpeed * KEY_REPEAT_HZ px/s
+static const float KEY_REPEAT_HZ = 30.0f;
+
+// Small deterministic PRNG (splitmix64) so every world owns its own sequence
+struct SimRng {
+    uint64_t state = 0;
+
+    void seed(uint64_t s) { state = s; }
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // uniform in [0,1)
+    float nextFloat() { return float(next() >> 40) * (1.0f / 16777216.0f); }
+};
+
+// Input gathered between two steps; consumed at the start of step()
+struct GameInput {
+    float padMove = 0.0f;     // relative paddle move (keyboard), in pixels
+    bool  hasPadTarget = false;
+    float padTarget = 0.0f;   // absolute paddle centre (mouse)
+    bool  launch = false;     // release the ball from the paddle
+};
+
+enum class SimEventType : uint8_t { PADDLE_HIT, BRICK_HIT, LOSE_LIFE, GAME_OVER, WIN, POWERUP, BRICK_DAMAGED, SCROLL };
+
+struct SimEvent {
+    SimEventType type;
+    float x, y;               // where it happened (ball or power-up centre)
+    uint32_t brick;           // BRICK_HIT/BRICK_DAMAGED: index into GameWorld::bricks
+};
+
+enum class RoundState { RUNNING, LOST, CLEARED };
+
+// FLOAT is the single-precision path. FIXED moves balls and power-ups,
+// collides and deflects in Q16.16 integer maths (fixed_point.h), so a seed
+// and an input stream give bit-identical state on any compiler and CPU.
+// State stays in the float fields either way; FIXED converts it in and out
+// each step, and both conversions are deterministic functions of the bits.
+// Bricks must lie within +-FIX_MAX_FLOAT (fitsFixedPoint).
+enum class PhysicsMode : uint8_t { FLOAT, FIXED };
+
+class GameWorld {
+public:
+    explicit GameWorld(uint64_t seed = 1);
+
+    void reseed(uint64_t seed) { rng.seed(seed); }
+
+    // Rebuild the brick layout and restart score/lives (new round). The
+    // default is the classic 4x8 wall; bigger grids shrink the bricks to fit.
+    void resetLevel(int rows = 4, int cols = 8);
+    // New round on a prepared level: `bricks` must already be ordered by
+    // `grid` (BrickGrid::build). `notResident` live bricks are still to be
+    // streamed in and keep the round from being cleared.
+    void loadLevel(BrickStore&& bricks, BrickGrid&& grid, uint32_t notResident = 0);
+    // New round on a prepared level (level.h). A streamed level keeps its
+    // stream: when no live brick is left on screen the playfield scrolls up
+    // to the next live bricks, paging chunks in and out (a SCROLL event).
+    void loadLevel(PreparedLevel&& level);
+    // True while playing a streamed level (it can scroll mid-round)
+    bool streamsLevel() const { return streaming; }
+    // New round on a copy of a prepared level. The copy reuses this world's
+    // storage, so restarting the same level again and again doesn't allocate.
+    void resetLevel(const BrickStore& bricks, const BrickGrid& grid);
+    // Swap the resident bricks mid-round (streaming), keeping score and balls
+    void replaceBricks(BrickStore&& bricks, BrickGrid&& grid, uint32_t notResident);
+    // Back to a single ball attached to the paddle
+    void resetBallOnPaddle();
+    // Every ball becomes three, fanned out by +-SPLIT_ANGLE (up to maxBalls)
+    void splitBalls();
+
+    // Advance the simulation by dt seconds. Events raised during the step are
+    // left in `events` until the next call.
+    void step(const GameInput& in, float dt);
+
+    // Positions blended between the previous and the current step (0 <= alpha <= 1)
+    float renderPadX(float alpha) const { return prevPadX + (padX - prevPadX) * alpha; }
+    float renderBallX(uint32_t i, float alpha) const { return balls.prevX[i] + (balls.x[i] - balls.prevX[i]) * alpha; }
+    float renderBallY(uint32_t i, float alpha) const { return balls.prevY[i] + (balls.y[i] - balls.prevY[i]) * alpha; }
+
+    bool roundOver() const { return round != RoundState::RUNNING; }
+
+    // Mark a brick dead and drop it from the alive list (O(1))
+    void killBrick(uint32_t i);
+    uint32_t aliveCount() const { return uint32_t(aliveBricks.size()); }
+
+    // Paddle
+    float padW = 120, padH = 20;
+    float padX = (WIN_W - padW)/2.0f;
+    float padY = 60.0f;
+    float padSpeed = 15.0f;
+    float paddleDeflect = PADDLE_DEFLECT;
+
+    // Balls. While stuck to the paddle there is exactly one.
+    BallPool balls;
+    float ballSize = 10.0f;              // radius of newly spawned balls
+    bool ballStuckToPaddle = true;
+    uint32_t maxBalls = 8192;
+    bool floorBounces = false;           // stress/practice: the bottom edge is a wall
+    PhysicsMode physics = PhysicsMode::FLOAT;
+
+    // Power-ups: capsules dropped by dying bricks, caught by the paddle
+    PowerUpPool powerUps;
+    float powerUpChance = 0.1f;          // per destroyed brick
+
+    // Round
+    int lives = 3;
+    int score = 0;
+    RoundState round = RoundState::RUNNING;
+    BrickStore bricks;
+    // Indices of live bricks (unordered, compacted on every kill) and each
+    // brick's slot in that list
+    std::vector<uint32_t> aliveBricks;
+    std::vector<uint32_t> aliveSlot;
+    BrickGrid grid;
+    uint32_t bricksNotResident = 0;
+    // Live bricks below the ceiling, and how far up the level the screen
+    // has scrolled (level y = screen y + scrollY)
+    uint32_t bricksOnScreen = 0;
+    float scrollY = 0.0f;
+
+    std::vector<SimEvent> events;
+    // State at the start of the last step, for render interpolation
+    float prevPadX = padX;
+    SimRng rng;
+
+private:
+    // A ball reaching a brick during the current step. Bricks die only once
+    // every ball has moved, so a tick's outcome doesn't depend on ball order.
+    struct BrickClaim {
+        uint32_t brick;
+        float t;              // time of impact as a fraction of the step
+        uint32_t ball;
+        float x, y;
+    };
+
+    void applyInput(const GameInput& in);
+    void clampPaddle();
+    void updateBalls(float dt);
+    // Move ball i through the step; false if it fell out of the bottom
+    bool moveBall(uint32_t i, float dt);
+    bool moveBallFixed(uint32_t i, float dt);
+    void resolveBrickClaims();
+    void updatePowerUps(float dt);
+    void rebuildBrickIndex();
+    void startRound();
+    void scrollLevel();
+    void snapPrevious() { prevPadX = padX; balls.snapPrevious(); }
+    void emit(SimEventType t, float x, float y, uint32_t brick = 0) { events.push_back({t, x, y, brick}); }
+
+    // Q16.16 copy of the brick boxes for PhysicsMode::FIXED, made per level
+    BrickBoxesFx brickBoxFx;
+    std::vector<BrickClaim> claims;
+    std::vector<uint32_t> ownHits;       // bricks the current ball already broke this step
+    std::vector<uint32_t> lostBalls;
+
+    // The level being scrolled through: its stream (when it has one, with
+    // the mapping it reads from) and where its lowest brick started on screen
+    LevelStream stream;
+    std::shared_ptr<MappedFile> streamFile;
+    bool streaming = false;
+    float levelFloor = 0.0f;
+};
+
+// The classic generated wall (rows x cols filling the upper playfield)
+void makeGridLevel(int rows, int cols, BrickStore& out);
+
+bool checkCollision(float ax, float ay, float aw, float ah, float bx, float by, float bw, float bh);
@@ -0,0 +1,73 @@
+// input.cpp - key/mouse state sampled once per simulation step
+#include "input.h"
+#include <algorithm>
+#include <cmath>
+
+void InputState::keyDown(InputKey k, double t) {
+    // GLUT repeats key-down while a key is held; only the first one counts
+    if(down[int(k)]) return;
+    down[int(k)] = true;
+    tapped[int(k)] = true;
+    noteEvent(t);
+}
+
+void InputState::keyUp(InputKey k, double t) {
+    if(!down[int(k)]) return;
+    down[int(k)] = false;
+    noteEvent(t);
+}
+
+void InputState::mouseMove(float x, double t) {
+    hasMouse = true;
+    mouseX = x;
+    noteEvent(t);
+}
+
+void InputState::launch(double t) {
+    launchPending = true;
+    noteEvent(t);
+}
+
+GameInput InputState::sample(float dt, float maxSpeed) {
+    GameInput in;
+    // A tap shorter than a step still moves the paddle for that step
+    bool left = down[int(InputKey::LEFT)] || tapped[int(InputKey::LEFT)];
+    bool right = down[int(InputKey::RIGHT)] || tapped[int(InputKey::RIGHT)];
+    int dir = (right ? 1 : 0) - (left ? 1 : 0);
+    if(dir == 0) {
+        velocity = 0.0f;
+    } else {
+        float target = dir * maxSpeed;
+        if(velocity * dir <= 0.0f) velocity = target * startSpeed;
+        float accel = maxSpeed * (1.0f - startSpeed) / std::max(accelSeconds, 1e-6f);
+        velocity = dir > 0 ? std::min(target, velocity + accel * dt) : std::max(target, velocity - accel * dt);
+        in.padMove = velocity * dt;
+    }
+    if(hasMouse) {
+        in.hasPadTarget = true;
+        in.padTarget = mouseX;
+        hasMouse = false;
+    }
+    in.launch = launchPending;
+    launchPending = false;
+    std::fill(tapped, tapped + int(InputKey::COUNT), false);
+
+    if(pendingSince >= 0.0 && (consumedSince < 0.0 || pendingSince < consumedSince)) consumedSince = pendingSince;
+    pendingSince = -1.0;
+    return in;
+}
+
+double InputState::takeConsumedEventTime() {
+    double t = consumedSince;
+    consumedSince = -1.0;
+    return t;
+}
+
+void InputState::clear() {
+    std::fill(down, down + int(InputKey::COUNT), false);
+    std::fill(tapped, tapped + int(InputKey::COUNT), false);
+    velocity = 0.0f;
+    hasMouse = false;
+    launchPending = false;
+    pendingSince = consumedSince = -1.0;
+}
@@ -0,0 +1,48 @@
+// input.h - key/mouse state sampled once per simulation step
+// GLUT callbacks only record what happened (with a timestamp); the game
+// turns that into one GameInput at the start of every fixed step. Held
+// arrow keys give a velocity-based paddle that doesn't depend on the OS
+// key-repeat delay or rate, and the oldest event consumed by each step is
+// remembered so the frame that shows it can report input-to-present latency.
+#pragma once
+#include "game_world.h"
+
+enum class InputKey : uint8_t { LEFT, RIGHT, COUNT };
+
+class InputState {
+public:
+    // A held key starts at this fraction of full speed and reaches full
+    // speed after accelSeconds; releasing it stops the paddle at once
+    float startSpeed = 0.5f;
+    float accelSeconds = 0.08f;
+
+    // Callbacks; `t` is monotonicSeconds() when the event arrived
+    void keyDown(InputKey k, double t);
+    void keyUp(InputKey k, double t);
+    void mouseMove(float x, double t);
+    void launch(double t);
+
+    // Input for one step of dt seconds with the paddle's full key speed (px/s)
+    GameInput sample(float dt, float maxSpeed);
+
+    // Time of the oldest event consumed by sample() since the last call, or
+    // a negative value if none; the caller pairs it with the present time
+    double takeConsumedEventTime();
+
+    // Forget held keys and pending events (state changes, focus loss)
+    void clear();
+
+    bool held(InputKey k) const { return down[int(k)]; }
+
+private:
+    void noteEvent(double t) { if(pendingSince < 0.0) pendingSince = t; }
+
+    bool down[int(InputKey::COUNT)] = {};
+    bool tapped[int(InputKey::COUNT)] = {};   // pressed since the last sample
+    float velocity = 0.0f;                    // px/s, signed
+    bool hasMouse = false;
+    float mouseX = 0.0f;
+    bool launchPending = false;
+    double pendingSince = -1.0;               // oldest event not yet sampled
+    double consumedSince = -1.0;              // oldest event sampled since takeConsumedEventTime()
+};
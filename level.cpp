@@ -0,0 +1,389 @@
+// level.cpp - level files: a text form for authoring, a chunked binary form for shipping
+#include "level.h"
+#include "asset_pack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char LEVEL_MAGIC[4] = {'D','X','L','V'};
+static const uint32_t LEVEL_VERSION = 1;
+
+struct LevelFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t brickCount;
+    uint32_t paletteCount;
+    uint32_t chunkCount;
+    uint32_t reserved[3];
+};
+
+struct LevelFileChunk {
+    float yMin, yMax;         // lowest brick bottom, highest brick top
+    uint32_t firstId, count;
+    uint64_t offset;          // x[count] y[] w[] h[] (float), palette[] (u16), hp[] (u8)
+};
+
+static_assert(sizeof(LevelFileHeader) == 32, "level header layout");
+static_assert(sizeof(LevelFileChunk) == 24, "level chunk layout");
+
+// ------------------- Text -------------------
+
+namespace {
+
+struct TextParser {
+    BrickStore& out;
+    std::string& error;
+    int line = 0;
+    int16_t keyPalette[128];
+    uint8_t keyHp[128];
+
+    TextParser(BrickStore& o, std::string& e) : out(o), error(e) {
+        std::fill(keyPalette, keyPalette + 128, int16_t(-1));
+        std::fill(keyHp, keyHp + 128, uint8_t(1));
+    }
+
+    bool fail(const char* what) {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "line %d: %s", line, what);
+        error = buf;
+        return false;
+    }
+
+    // Next whitespace-separated token in [p, end); false at the end of the line
+    static bool token(const char*& p, const char* end, const char*& tok, size_t& len) {
+        while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if(p >= end || *p == '#') return false;
+        tok = p;
+        while(p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '#') p++;
+        len = size_t(p - tok);
+        return true;
+    }
+
+    static bool number(const char*& p, const char* end, float& v) {
+        const char* tok;
+        size_t len;
+        if(!token(p, end, tok, len) || len >= 32) return false;
+        char buf[32];
+        std::memcpy(buf, tok, len);
+        buf[len] = 0;
+        char* stop;
+        v = std::strtof(buf, &stop);
+        return stop == buf + len;
+    }
+
+    static bool is(const char* tok, size_t len, const char* word) {
+        return std::strlen(word) == len && std::memcmp(tok, word, len) == 0;
+    }
+
+    bool hits(float v, uint8_t& hp) {
+        if(!(v >= 1.0f && v <= 255.0f)) return fail("hp must be 1..255");
+        hp = uint8_t(v);
+        return true;
+    }
+
+    bool paletteKey(const char* tok, size_t len, int& key) {
+        if(len != 1 || (unsigned char)tok[0] >= 128 || tok[0] == '.') return fail("palette keys are single characters other than '.'");
+        key = tok[0];
+        return true;
+    }
+
+    bool color(const char* p, const char* end) {
+        const char* tok;
+        size_t len;
+        int key;
+        if(!token(p, end, tok, len) || !paletteKey(tok, len, key)) return fail("color needs a key");
+        Color c = {0, 0, 0, 1};
+        if(!number(p, end, c.r) || !number(p, end, c.g) || !number(p, end, c.b)) return fail("color needs r g b");
+        uint8_t hp = 1;
+        while(token(p, end, tok, len)) {
+            float v;
+            if(is(tok, len, "hp")) {
+                if(!number(p, end, v) || !hits(v, hp)) return false;
+            } else {
+                char buf[32];
+                size_t n = std::min(len, sizeof(buf) - 1);
+                std::memcpy(buf, tok, n);
+                buf[n] = 0;
+                char* stop;
+                c.a = std::strtof(buf, &stop);
+                if(stop != buf + n) return fail("bad color alpha");
+            }
+        }
+        if(out.palette.size() >= 65535) return fail("too many colours");
+        keyPalette[key] = int16_t(out.addColor(c));
+        keyHp[key] = hp;
+        return true;
+    }
+
+    bool brick(const char* p, const char* end) {
+        float x, y, w, h;
+        if(!number(p, end, x) || !number(p, end, y) || !number(p, end, w) || !number(p, end, h))
+            return fail("brick needs x y w h");
+        if(!(w > 0.0f && h > 0.0f)) return fail("brick size must be positive");
+        const char* tok;
+        size_t len;
+        int key;
+        if(!token(p, end, tok, len) || !paletteKey(tok, len, key)) return false;
+        if(keyPalette[key] < 0) return fail("unknown colour key");
+        uint8_t hp = keyHp[key];
+        float v;
+        if(number(p, end, v) && !hits(v, hp)) return false;
+        out.add(x, y, w, h, uint16_t(keyPalette[key]), hp);
+        return true;
+    }
+
+    // The map rows themselves are consumed by parse()
+    bool gridHeader(const char* p, const char* end, float g[6]) {
+        for(int i=0;i<6;i++) if(!number(p, end, g[i])) return fail("grid needs left top brickW brickH gapX gapY");
+        if(!(g[2] > 0.0f && g[3] > 0.0f)) return fail("grid brick size must be positive");
+        return true;
+    }
+
+    bool gridRow(const char* p, const char* end, const float g[6], int row) {
+        float y = g[1] - (row + 1) * (g[3] + g[5]);
+        for(int col=0; p < end && *p != '\r' && *p != '#'; p++, col++) {
+            if(*p == '.' || *p == ' ') continue;
+            int key = (unsigned char)*p;
+            if(key >= 128 || keyPalette[key] < 0) return fail("unknown colour key in grid");
+            out.add(g[0] + col * (g[2] + g[4]), y, g[2], g[3], uint16_t(keyPalette[key]), keyHp[key]);
+        }
+        return true;
+    }
+
+    bool parse(const char* text, size_t len) {
+        const char* p = text;
+        const char* end = text + len;
+        bool inGrid = false;
+        int gridRowIndex = 0;
+        float g[6] = {};
+        while(p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', size_t(end - p)));
+            if(!eol) eol = end;
+            line++;
+            const char* q = p;
+            const char* tok;
+            size_t tlen;
+            bool any = token(q, eol, tok, tlen);
+            if(inGrid) {
+                if(any && is(tok, tlen, "end")) inGrid = false;
+                // from the line start: leading spaces are empty cells too
+                else if(any && !gridRow(p, eol, g, gridRowIndex++)) return false;
+            } else if(any) {
+                if(is(tok, tlen, "color")) { if(!color(q, eol)) return false; }
+                else if(is(tok, tlen, "brick")) { if(!brick(q, eol)) return false; }
+                else if(is(tok, tlen, "grid")) {
+                    if(!gridHeader(q, eol, g)) return false;
+                    inGrid = true;
+                    gridRowIndex = 0;
+                }
+                else if(!is(tok, tlen, "name")) return fail("unknown statement");
+            }
+            p = eol + 1;
+        }
+        if(inGrid) return fail("grid without end");
+        return true;
+    }
+};
+
+} // namespace
+
+bool parseLevelText(const char* text, size_t len, BrickStore& out, std::string& error) {
+    out.clear();
+    TextParser parser(out, error);
+    return parser.parse(text, len);
+}
+
+// ------------------- Binary -------------------
+
+bool isLevelBinary(const uint8_t* data, size_t size) {
+    return size >= sizeof(LevelFileHeader) && std::memcmp(data, LEVEL_MAGIC, 4) == 0;
+}
+
+template<class T>
+static void putArray(std::vector<uint8_t>& out, const T* v, size_t n) {
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(v);
+    out.insert(out.end(), b, b + n * sizeof(T));
+}
+
+bool writeLevelBinary(const BrickStore& s, std::vector<uint8_t>& out, uint32_t chunkBricks) {
+    if(chunkBricks == 0 || s.palette.size() > 65535) return false;
+    std::vector<uint32_t> order;
+    order.reserve(s.count);
+    for(uint32_t i=0; i<s.count; i++) if(s.alive(i)) order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if(s.y[a] != s.y[b]) return s.y[a] < s.y[b];
+        return s.x[a] < s.x[b];
+    });
+    uint32_t n = uint32_t(order.size());
+    uint32_t chunkCount = (n + chunkBricks - 1) / chunkBricks;
+
+    LevelFileHeader h = {};
+    std::memcpy(h.magic, LEVEL_MAGIC, 4);
+    h.version = LEVEL_VERSION;
+    h.brickCount = n;
+    h.paletteCount = uint32_t(s.palette.size());
+    h.chunkCount = chunkCount;
+    out.clear();
+    putArray(out, &h, 1);
+    putArray(out, s.palette.data(), s.palette.size());
+    size_t tableAt = out.size();
+    out.resize(out.size() + chunkCount * sizeof(LevelFileChunk));
+
+    std::vector<float> fx, fy, fw, fh;
+    std::vector<uint16_t> fp;
+    std::vector<uint8_t> fhp;
+    for(uint32_t c=0; c<chunkCount; c++) {
+        uint32_t first = c * chunkBricks, cnt = std::min(chunkBricks, n - first);
+        fx.clear(); fy.clear(); fw.clear(); fh.clear(); fp.clear(); fhp.clear();
+        LevelFileChunk ch = {1e30f, -1e30f, first, cnt, 0};
+        for(uint32_t k=first; k<first+cnt; k++) {
+            uint32_t i = order[k];
+            fx.push_back(s.x[i]); fy.push_back(s.y[i]); fw.push_back(s.w[i]); fh.push_back(s.h[i]);
+            fp.push_back(s.paletteIndex[i]);
+            fhp.push_back(std::max<uint8_t>(1, s.hp[i]));
+            ch.yMin = std::min(ch.yMin, s.y[i]);
+            ch.yMax = std::max(ch.yMax, s.y[i] + s.h[i]);
+        }
+        out.resize((out.size() + 7) & ~size_t(7), 0);
+        ch.offset = out.size();
+        putArray(out, fx.data(), cnt); putArray(out, fy.data(), cnt);
+        putArray(out, fw.data(), cnt); putArray(out, fh.data(), cnt);
+        putArray(out, fp.data(), cnt); putArray(out, fhp.data(), cnt);
+        std::memcpy(&out[tableAt + c * sizeof(LevelFileChunk)], &ch, sizeof(ch));
+    }
+    return true;
+}
+
+static size_t chunkBytes(uint32_t n) { return size_t(n) * (4 * sizeof(float) + sizeof(uint16_t) + 1); }
+
+bool LevelStream::open(const uint8_t* data, size_t len, std::string& error) {
+    base = nullptr;
+    chunks.clear();
+    palette.clear();
+    destroyedBits.clear();
+    brickCount = 0;
+    if(!isLevelBinary(data, len)) { error = "not a binary level"; return false; }
+    LevelFileHeader h;
+    std::memcpy(&h, data, sizeof(h));
+    size_t paletteAt = sizeof(h);
+    size_t tableAt = paletteAt + size_t(h.paletteCount) * sizeof(Color);
+    if(h.version != LEVEL_VERSION || h.paletteCount > 65535 ||
+       tableAt + size_t(h.chunkCount) * sizeof(LevelFileChunk) > len) { error = "bad level header"; return false; }
+
+    palette.resize(h.paletteCount);
+    std::memcpy(palette.data(), data + paletteAt, h.paletteCount * sizeof(Color));
+    uint64_t expectId = 0;
+    for(uint32_t c=0; c<h.chunkCount; c++) {
+        LevelFileChunk fc;
+        std::memcpy(&fc, data + tableAt + c * sizeof(fc), sizeof(fc));
+        if(fc.firstId != expectId || fc.offset % 8 != 0 || fc.offset > len || chunkBytes(fc.count) > len - fc.offset) {
+            error = "bad level chunk table";
+            return false;
+        }
+        const uint16_t* pal = reinterpret_cast<const uint16_t*>(data + fc.offset + size_t(fc.count) * 16);
+        for(uint32_t k=0; k<fc.count; k++) {
+            if(pal[k] >= h.paletteCount) { error = "brick colour out of range"; return false; }
+        }
+        chunks.push_back({fc.yMin, fc.yMax, fc.firstId, fc.count, fc.offset, 0, false});
+        expectId += fc.count;
+    }
+    if(expectId != h.brickCount) { error = "brick count mismatch"; return false; }
+    base = data;
+    size = len;
+    brickCount = h.brickCount;
+    destroyedBits.assign(brickCount / 64 + 1, 0);
+    return true;
+}
+
+uint32_t LevelStream::residentChunks() const {
+    uint32_t n = 0;
+    for(const Chunk& c : chunks) n += c.resident ? 1 : 0;
+    return n;
+}
+
+uint32_t LevelStream::notResident() const {
+    uint32_t n = 0;
+    for(const Chunk& c : chunks) if(!c.resident) n += c.count - c.destroyed;
+    return n;
+}
+
+bool LevelStream::lowestOutside(float& y) const {
+    bool any = false;
+    for(const Chunk& c : chunks) {
+        if(c.resident || c.destroyed == c.count || (any && c.yMin >= y)) continue;
+        y = c.yMin;
+        any = true;
+    }
+    return any;
+}
+
+bool LevelStream::setWindow(float y0, float y1, const BrickStore* current, BrickStore& out) {
+    if(!base) return false;
+    if(current) {
+        for(uint32_t i=0; i<current->count; i++) {
+            uint32_t id = current->id[i];
+            if(current->alive(i) || id >= brickCount) continue;
+            uint64_t bit = uint64_t(1) << (id & 63);
+            if(destroyedBits[id >> 6] & bit) continue;
+            destroyedBits[id >> 6] |= bit;
+            auto it = std::upper_bound(chunks.begin(), chunks.end(), id,
+                                       [](uint32_t v, const Chunk& c) { return v < c.firstId; });
+            (it - 1)->destroyed++;
+        }
+    }
+
+    bool changed = false;
+    uint32_t total = 0;
+    for(Chunk& c : chunks) {
+        bool want = c.count > 0 && c.yMax >= y0 && c.yMin <= y1;
+        changed |= (want != c.resident);
+        c.resident = want;
+        if(want) total += c.count;
+    }
+    if(!changed && current) return false;
+
+    out.clear();
+    out.palette = palette;
+    out.reserve(total);
+    for(const Chunk& c : chunks) {
+        if(!c.resident) continue;
+        const uint8_t* p = base + c.offset;
+        size_t n = c.count;
+        const float* x = reinterpret_cast<const float*>(p);
+        const uint16_t* pal = reinterpret_cast<const uint16_t*>(p + n * 16);
+        const uint8_t* hp = p + n * 18;
+        uint32_t at = out.count;
+        out.append(c.count, x, x + n, x + 2*n, x + 3*n, pal, hp, c.firstId);
+        if(c.destroyed) {
+            for(uint32_t k=0; k<c.count; k++) {
+                uint32_t id = c.firstId + k;
+                if(destroyedBits[id >> 6] >> (id & 63) & 1) out.setAlive(at + k, false);
+            }
+        }
+    }
+    return true;
+}
+
+// ------------------- Preparing -------------------
+
+bool prepareLevel(const uint8_t* data, size_t size, float y0, float y1, PreparedLevel& out, std::string& error) {
+    out.streamed = false;
+    if(isLevelBinary(data, size)) {
+        if(!out.stream.open(data, size, error)) return false;
+        out.stream.setWindow(y0, y1, nullptr, out.bricks);
+        out.streamed = true;
+    } else if(!parseLevelText(reinterpret_cast<const char*>(data), size, out.bricks, error)) {
+        return false;
+    }
+    if(out.bricks.count == 0 && out.notResident() == 0) { error = "level has no bricks"; return false; }
+    out.grid.build(out.bricks);
+    return true;
+}
+
+bool prepareLevelFile(const std::string& path, float y0, float y1, PreparedLevel& out, std::string& error) {
+    std::shared_ptr<MappedFile> f(new MappedFile());
+    if(!f->open(path.c_str())) { error = "cannot open " + path; return false; }
+    out.file = f;
+    return prepareLevel(f->data(), f->size(), y0, y1, out, error);
+}
@@ -0,0 +1,87 @@
+// level.h - level files: a text form for authoring, a chunked binary form for shipping
+//
+// Text (.lvl), one statement per line, '#' starts a comment:
+//   color A 0.90 0.30 0.30 [alpha] [hp N]   palette entry with a one-character key
+//   brick x y w h A [hp]                    one brick (bottom-left corner, size)
+//   grid left top brickW brickH gapX gapY   a character map follows, one row per
+//   AAAA..BB                                line, top row first, '.' or ' ' = no
+//   end                                     brick (columns count from the start
+//                                           of the line), until "end"
+//
+// Binary (.lvb): header, palette, then bricks sorted bottom-to-top in chunks
+// of column arrays (x, y, w, h, palette, hp). A chunk is copied straight into
+// a BrickStore, and LevelStream keeps only the chunks overlapping a vertical
+// window resident, so a level bigger than the memory budget can be scrolled
+// through while the file stays mapped. In play GameWorld owns the stream and
+// moves the window up a screen whenever the bricks on screen are cleared.
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "brick_store.h"
+#include "brick_grid.h"
+
+class MappedFile;
+
+static const uint32_t LEVEL_CHUNK_BRICKS = 4096;
+
+bool parseLevelText(const char* text, size_t len, BrickStore& out, std::string& error);
+bool isLevelBinary(const uint8_t* data, size_t size);
+// Bricks are written in level-id order, which is bottom-to-top
+bool writeLevelBinary(const BrickStore& s, std::vector<uint8_t>& out, uint32_t chunkBricks = LEVEL_CHUNK_BRICKS);
+
+class LevelStream {
+public:
+    // `data` (a binary level) must stay valid while the stream is used
+    bool open(const uint8_t* data, size_t size, std::string& error);
+
+    uint32_t totalBricks() const { return brickCount; }
+    uint32_t chunkCount() const { return uint32_t(chunks.size()); }
+    uint32_t residentChunks() const;
+    // Live bricks in chunks outside the window
+    uint32_t notResident() const;
+    // Bottom of the lowest chunk outside the window that still has live
+    // bricks; false if there is none
+    bool lowestOutside(float& y) const;
+
+    // Bricks that died in `current` (a store filled by this stream) are
+    // remembered, then `out` is refilled with the chunks overlapping
+    // [y0, y1]. Returns false if the resident set didn't change (`out` is
+    // then left alone). `current` and `out` may be the same store.
+    bool setWindow(float y0, float y1, const BrickStore* current, BrickStore& out);
+
+private:
+    struct Chunk {
+        float yMin, yMax;
+        uint32_t firstId, count;
+        uint64_t offset;
+        uint32_t destroyed;
+        bool resident;
+    };
+
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    uint32_t brickCount = 0;
+    std::vector<Color> palette;
+    std::vector<Chunk> chunks;
+    std::vector<uint64_t> destroyedBits;    // by level id
+};
+
+// A level ready to hand to GameWorld::loadLevel: bricks ordered by the grid.
+// Binary levels keep their stream (and the mapping it reads from).
+struct PreparedLevel {
+    BrickStore bricks;
+    BrickGrid grid;
+    LevelStream stream;
+    bool streamed = false;
+    std::shared_ptr<MappedFile> file;
+
+    uint32_t notResident() const { return streamed ? stream.notResident() : 0; }
+};
+
+// Parse text or binary level bytes; binary levels load the chunks in
+// [y0, y1] and `data` must outlive `out`
+bool prepareLevel(const uint8_t* data, size_t size, float y0, float y1, PreparedLevel& out, std::string& error);
+// Same from a file on disk (mapped and owned by `out`)
+bool prepareLevelFile(const std::string& path, float y0, float y1, PreparedLevel& out, std::string& error);
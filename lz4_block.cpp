@@ -0,0 +1,91 @@
+// lz4_block.cpp - minimal LZ4 block-format codec
+#include "lz4_block.h"
+#include <cstring>
+
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;     // block must end with >= 5 literals
+static const size_t MF_LIMIT = 12;         // no match may start in the last 12 bytes
+static const int HASH_BITS = 16;
+
+static uint32_t read32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+static uint32_t hash4(uint32_t v) { return (v * 2654435761u) >> (32 - HASH_BITS); }
+
+static void writeLength(std::vector<uint8_t>& out, size_t len) {
+    while(len >= 255) { out.push_back(255); len -= 255; }
+    out.push_back(uint8_t(len));
+}
+
+static void emitSequence(std::vector<uint8_t>& out, const uint8_t* lit, size_t litLen,
+                         size_t matchLen, size_t offset) {
+    size_t token = out.size();
+    out.push_back(0);
+    uint8_t t = uint8_t((litLen >= 15 ? 15 : litLen) << 4);
+    if(litLen >= 15) writeLength(out, litLen - 15);
+    out.insert(out.end(), lit, lit + litLen);
+    if(matchLen) {
+        out.push_back(uint8_t(offset));
+        out.push_back(uint8_t(offset >> 8));
+        size_t ml = matchLen - MIN_MATCH;
+        t |= uint8_t(ml >= 15 ? 15 : ml);
+        if(ml >= 15) writeLength(out, ml - 15);
+    }
+    out[token] = t;
+}
+
+size_t lz4CompressBlock(const uint8_t* src, size_t n, std::vector<uint8_t>& dst) {
+    dst.clear();
+    dst.reserve(n + n / 255 + 16);
+    size_t anchor = 0;
+    if(n > MF_LIMIT) {
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0xFFFFFFFFu);
+        size_t matchLimit = n - LAST_LITERALS;
+        size_t i = 0;
+        while(i + MF_LIMIT < n) {
+            uint32_t seq = read32(src + i);
+            uint32_t h = hash4(seq);
+            size_t cand = table[h];
+            table[h] = uint32_t(i);
+            if(cand == 0xFFFFFFFFu || i - cand > 65535 || read32(src + cand) != seq) { i++; continue; }
+            size_t len = MIN_MATCH;
+            while(i + len < matchLimit && src[cand + len] == src[i + len]) len++;
+            emitSequence(dst, src + anchor, i - anchor, len, i - cand);
+            i += len;
+            anchor = i;
+        }
+    }
+    emitSequence(dst, src + anchor, n - anchor, 0, 0);
+    return dst.size();
+}
+
+bool lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcSize;
+    size_t op = 0;
+    while(ip < iend) {
+        uint8_t token = *ip++;
+        size_t lit = token >> 4;
+        if(lit == 15) {
+            uint8_t b;
+            do { if(ip >= iend) return false; b = *ip++; lit += b; } while(b == 255);
+        }
+        if(size_t(iend - ip) < lit || dstSize - op < lit) return false;
+        std::memcpy(dst + op, ip, lit);
+        ip += lit; op += lit;
+        if(ip >= iend) break;                 // last sequence has no match
+        if(iend - ip < 2) return false;
+        size_t offset = size_t(ip[0]) | (size_t(ip[1]) << 8);
+        ip += 2;
+        if(offset == 0 || offset > op) return false;
+        size_t ml = (token & 15);
+        if(ml == 15) {
+            uint8_t b;
+            do { if(ip >= iend) return false; b = *ip++; ml += b; } while(b == 255);
+        }
+        ml += MIN_MATCH;
+        if(dstSize - op < ml) return false;
+        // overlapping copy must go byte by byte
+        for(size_t k=0; k<ml; k++) dst[op + k] = dst[op - offset + k];
+        op += ml;
+    }
+    return op == dstSize;
+}
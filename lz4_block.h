@@ -0,0 +1,13 @@
+// lz4_block.h - minimal LZ4 block-format codec (no frame format, no dictionaries)
+// Output is compatible with the reference LZ4_decompress_safe /
+// LZ4_compress_default block format, so packs can also be produced by other tools.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compress src into dst (replacing its contents); returns the compressed size
+size_t lz4CompressBlock(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst);
+
+// Decompress exactly dstSize bytes; returns false on malformed input
+bool lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
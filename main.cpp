@@ -1,775 +1,1438 @@
-// dxball_normal_ball_updated_ui.cpp
-#include <GL/glut.h>
-#include <cmath>
-#include <vector>
-#include <string>
-#include <cstdlib>
-#include <algorithm>
-#include <windows.h>
-#include <mmsystem.h>
-#include <ctime>
-#include <fstream>   // for checking file existence
-#include <iostream>
-
-#pragma comment(lib, "winmm.lib")
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
-struct Color { float r,g,b,a; };
-struct Block {
-    float x,y,w,h;
-    bool alive;
-    Color color;
-};
-
-enum class GameState { MENU, PLAYING, GAME_OVER, WIN };
-enum class MenuScreen { MAIN, PLAYER_NAME, SCORE_BOARD };
-
-static const int WIN_W = 900;
-static const int WIN_H = 700;
-
-static GameState gState = GameState::MENU;
-static MenuScreen currentScreen = MenuScreen::MAIN;
-static int menuSelection = 0;
-
-// Player info
-static int currentPlayer = 0;
-static std::string playerNames[3] = {"Player1", "Player2", "Player3"};
-static std::string playerName = playerNames[currentPlayer];
-static bool nameInputMode = false;
-static std::string tempName = "";
-
-// Per-player best scores
-static int playerScores[3] = {0, 0, 0};
-
-// Global scoreboard: stores all finished runs (name, score)
-static std::vector<std::pair<std::string,int>> scoreboard;
-
-// Flag to ensure a round's score is recorded only once
-static bool scoreRecordedThisRound = false;
-
-// Paddle
-static float padW = 120, padH = 20;
-static float padX = (WIN_W - padW)/2.0f;
-static float padY = 60.0f;
-static float padSpeed = 15.0f;
-
-// Ball (normal) - changed color later in draw
-static float ballX = WIN_W/2.0f;
-static float ballY = padY + padH + 18.0f;
-static float ballVX = 8.0f;
-static float ballVY = 10.0f;
-static float ballSize = 10.0f;
-
-// Gameplay
-static int lives = 3;
-static int score = 0;
-static bool ballStuckToPaddle = true;
-static std::vector<Block> blocks;
-
-// UI pulse for menu selection
-static float menuPulse = 0.0f;
-
-// ------------------- SOUND (UPDATED) -------------------
-// Behavior:
-// - Prefer external cartoon .wav files if present in exe directory:
-//     cartoon_hit.wav, cartoon_paddle.wav, cartoon_lose.wav, cartoon_win.wav, cartoon_menu.wav
-// - If files not present, fallback to Windows system aliases defined below.
-// - Press 'M' to toggle sound ON/OFF. Sound state shown in HUD/footer.
-// - If sound is disabled, no PlaySound calls are made.
-
-static bool soundEnabled = true;
-
-// External filenames (place your .wav files next to exe to use them)
-static const char* CART_HIT_FILE    = "cartoon_hit.wav";
-static const char* CART_PADDLE_FILE = "cartoon_paddle.wav";
-static const char* CART_LOSE_FILE   = "cartoon_lose.wav";
-static const char* CART_WIN_FILE    = "cartoon_win.wav";
-static const char* CART_MENU_FILE   = "cartoon_menu.wav";
-
-// Fallback aliases (Windows)
-static const char* SND_HIT_BRICK   = "SystemAsterisk";
-static const char* SND_PADDLE_HIT  = "SystemExclamation";
-static const char* SND_LOSE_LIFE   = "SystemHand";
-static const char* SND_GAME_WIN    = "SystemExit";
-static const char* SND_MENU_NAV    = "SystemStart";
-
-inline bool fileExists(const char* path) {
-    std::ifstream f(path);
-    return f.good();
-}
-
-// Play a cartoon file if available, otherwise fallback to alias.
-// If both unavailable or sound disabled, do nothing.
-inline void playSfxFileOrAlias(const char* filePath, const char* alias) {
-    if(!soundEnabled) return;
-    if(filePath && fileExists(filePath)) {
-        PlaySoundA(filePath, NULL, SND_ASYNC | SND_FILENAME);
-    } else if(alias) {
-        PlaySoundA(alias, NULL, SND_ASYNC | SND_ALIAS);
-    }
-}
-// --------------------------------------------
-
-void drawText(float x, float y, const std::string& s, void* font = GLUT_BITMAP_HELVETICA_18, Color c = {1,1,1,1}) {
-    glColor4f(c.r, c.g, c.b, c.a);
-    glRasterPos2f(x, y);
-    for(char ch : s) glutBitmapCharacter(font, ch);
-}
-
-// Update best score for currentPlayer (keeps per-player best)
-void saveBestForCurrentPlayer() {
-    if(currentPlayer >= 0 && currentPlayer < 3) {
-        playerScores[currentPlayer] = std::max(playerScores[currentPlayer], score);
-    }
-}
-
-// Record this finished round (name,score) into the global scoreboard once per round
-void recordScoreboardEntryIfNeeded() {
-    if(scoreRecordedThisRound) return;
-    if(playerName.empty()) return;
-    scoreboard.push_back({playerName, score});
-    scoreRecordedThisRound = true;
-}
-
-// Reset position + velocities and attach ball to paddle
-void resetBallOnPaddle() {
-    ballX = padX + padW/2.0f;
-    ballY = padY + padH + 18.0f;
-    ballVX = 8.0f * ((std::rand()%2)?1:-1);
-    ballVY = 10.0f;
-    ballStuckToPaddle = true;
-}
-
-// Reset a level / start a new round
-void resetLevel() {
-    blocks.clear();
-    int rows = 4, cols = 8;
-    float marginX = 80, marginY = 100, gapX = 10, gapY = 8;
-    float bw = (WIN_W - 2*marginX - (cols-1)*gapX) / cols;
-    float bh = 35.0f;
-
-    for(int r=0;r<rows;r++){
-        for(int c=0;c<cols;c++){
-            Block b;
-            b.x = marginX + c*(bw+gapX);
-            b.y = WIN_H - marginY - (r+1)*(bh+gapY);
-            b.w = bw; b.h = bh;
-            b.alive = true;
-            float fr = 0.15f + 0.7f * (float(c) / float(std::max(1, cols-1)));
-            float fg = 0.15f + 0.6f * (float((r + c) % cols) / float(std::max(1, cols-1)));
-            float fb = 0.35f + 0.5f * (float(r) / float(std::max(1, rows-1)));
-            b.color = {fr, fg, fb, 1.0f};
-            blocks.push_back(b);
-        }
-    }
-    score = 0;
-    lives = 3;
-    resetBallOnPaddle();
-    scoreRecordedThisRound = false;
-}
-
-void nextPlayer() {
-    currentPlayer = (currentPlayer + 1) % 3;
-    playerName = playerNames[currentPlayer];
-    padSpeed += 2.0f;
-    resetLevel();
-}
-
-// Draw a simple filled circle (normal ball) - changed to bluish ball with subtle gloss
-void drawBall(float cx, float cy, float r) {
-    const int segments = 40;
-    // glossy gradient: center lighter, rim darker
-    glBegin(GL_TRIANGLE_FAN);
-    glColor4f(0.6f, 0.85f, 1.0f, 1.0f); // center: light blue
-    glVertex2f(cx, cy);
-    for(int i=0;i<=segments;i++){
-        float theta = 2.0f * M_PI * float(i) / float(segments);
-        float x = cx + cosf(theta) * r;
-        float y = cy + sinf(theta) * r;
-        glColor4f(0.15f, 0.5f, 0.9f, 1.0f);
-        glVertex2f(x,y);
-    }
-    glEnd();
-
-    // subtle bright highlight
-    glBegin(GL_TRIANGLE_FAN);
-    glColor4f(1.0f,1.0f,1.0f,0.35f);
-    glVertex2f(cx - r*0.3f, cy + r*0.35f);
-    for(int i=0;i<=16;i++){
-        float theta = M_PI * float(i) / 16.0f;
-        float x = (cx - r*0.3f) + cosf(theta) * r*0.35f;
-        float y = (cy + r*0.35f) + sinf(theta) * r*0.35f;
-        glVertex2f(x,y);
-    }
-    glEnd();
-
-    // outline
-    glColor4f(0.03f,0.08f,0.15f,1.0f);
-    glLineWidth(1.0f);
-    glBegin(GL_LINE_LOOP);
-    for(int i=0;i<=segments;i++){
-        float theta = 2.0f * M_PI * float(i) / float(segments);
-        float x = cx + cosf(theta) * r;
-        float y = cy + sinf(theta) * r;
-        glVertex2f(x,y);
-    }
-    glEnd();
-}
-
-// Draw a simple paddle (green with subtle shine)
-void drawPaddle(float x, float y, float w, float h) {
-    // Base rectangle (green)
-    glBegin(GL_QUADS);
-    glColor4f(0.12f, 0.7f, 0.3f, 1.0f); // new paddle color: green
-    glVertex2f(x, y); glVertex2f(x+w, y);
-    glVertex2f(x+w, y+h); glVertex2f(x, y+h);
-    glEnd();
-
-    // Top glossy strip
-    glBegin(GL_QUADS);
-    glColor4f(1.0f,1.0f,1.0f,0.12f);
-    glVertex2f(x+2, y+h-6); glVertex2f(x+w-2, y+h-6);
-    glVertex2f(x+w-2, y+h-2); glVertex2f(x+2, y+h-2);
-    glEnd();
-
-    // Simple stripes (light)
-    glLineWidth(2.0f);
-    glBegin(GL_LINES);
-    glColor4f(0.9f,0.95f,0.9f,0.25f);
-    for(float sx = x + 12.0f; sx < x + w - 12.0f; sx += 24.0f) {
-        glVertex2f(sx, y+6.0f);
-        glVertex2f(sx+10.0f, y+h-6.0f);
-    }
-    glEnd();
-
-    // Outline
-    glColor4f(0.02f,0.05f,0.03f,1.0f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x, y); glVertex2f(x+w, y);
-    glVertex2f(x+w, y+h); glVertex2f(x, y+h);
-    glEnd();
-}
-
-// Draw a simple brick rectangle (kept but with slight bevel effect)
-void drawBrick(const Block &b) {
-    if(!b.alive) return;
-    // base
-    glBegin(GL_QUADS);
-    glColor4f(b.color.r, b.color.g, b.color.b, b.color.a);
-    glVertex2f(b.x, b.y); glVertex2f(b.x + b.w, b.y);
-    glVertex2f(b.x + b.w, b.y + b.h); glVertex2f(b.x, b.y + b.h);
-    glEnd();
-
-    // light top strip to simulate bevel
-    glBegin(GL_QUADS);
-    glColor4f(1.0f,1.0f,1.0f,0.08f);
-    glVertex2f(b.x+2, b.y + b.h - 8);
-    glVertex2f(b.x + b.w - 2, b.y + b.h - 8);
-    glVertex2f(b.x + b.w - 2, b.y + b.h);
-    glVertex2f(b.x+2, b.y + b.h);
-    glEnd();
-
-    // outline
-    glColor4f(0.02f,0.02f,0.02f,0.7f);
-    glLineWidth(1.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(b.x, b.y); glVertex2f(b.x + b.w, b.y);
-    glVertex2f(b.x + b.w, b.y + b.h); glVertex2f(b.x, b.y + b.h);
-    glEnd();
-}
-
-void drawMainMenu() {
-    // New background gradient: dark teal -> deep purple
-    glBegin(GL_QUADS);
-    glColor4f(0.02f, 0.08f, 0.10f, 1.0f); // bottom
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glColor4f(0.08f, 0.02f, 0.12f, 1.0f); // top
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    // Title with a new color (soft cyan)
-    drawText(WIN_W/2-100, WIN_H-100, "DX BALL", GLUT_BITMAP_TIMES_ROMAN_24, {0.55f,0.95f,0.98f,1});
-
-    // Menu options
-    std::string menuItems[] = {
-        "1. START GAME",
-        "2. PLAYER NAME: " + playerName,
-        "3. SCORE BOARD",
-        "4. EXIT"
-    };
-
-    for(int i=0; i<4; i++) {
-        // pulsing highlight for selected option
-        Color c;
-        if(i == menuSelection) {
-            float pulse = 0.6f + 0.4f * (0.5f * (1.0f + sinf(menuPulse))); // between 0.6 and 1.0
-            c = Color{pulse*0.6f, pulse*0.95f, 1.0f, 1.0f}; // cyan-ish highlight
-        } else {
-            c = Color{0.9f,0.9f,0.95f,1};
-        }
-        drawText(WIN_W/2-120, WIN_H-180-i*50, menuItems[i], GLUT_BITMAP_HELVETICA_18, c);
-    }
-
-    // Small footer lines (subtle) + sound status
-    std::string footer = "Use NUMBER KEYS 1-4 to select menu  |  ENTER to confirm  |  ESC to go back";
-    drawText(WIN_W/2-210, 110, footer, GLUT_BITMAP_9_BY_15, {0.7f,0.8f,0.9f,0.7f});
-
-    std::string soundStatus = std::string("Sound: ") + (soundEnabled ? "ON (Press M to mute)" : "OFF (Press M to unmute)");
-    drawText(WIN_W/2-160, 80, soundStatus, GLUT_BITMAP_9_BY_15, {0.8f,0.85f,1.0f,0.9f});
-}
-
-void drawPlayerNameScreen() {
-    // Background: slightly lighter than main menu
-    glBegin(GL_QUADS);
-    glColor4f(0.03f, 0.06f, 0.08f, 1.0f);
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glColor4f(0.06f, 0.03f, 0.09f, 1.0f);
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    drawText(WIN_W/2-150, WIN_H-100, "CHANGE PLAYER NAME", GLUT_BITMAP_TIMES_ROMAN_24, {0.9f,0.7f,0.2f,1});
-
-    // Current player info
-    drawText(WIN_W/2-100, WIN_H-160, "Current Player: " + playerName, GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-    drawText(WIN_W/2-120, WIN_H-200, "Player " + std::to_string(currentPlayer+1) + " of 3", GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-
-    // Name input
-    drawText(WIN_W/2-80, WIN_H-260, "Enter new name:", GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-
-    // Input box (accented)
-    glBegin(GL_QUADS);
-    glColor4f(0.15f, 0.15f, 0.22f, 0.95f);
-    glVertex2f(WIN_W/2-100, WIN_H-300);
-    glVertex2f(WIN_W/2+100, WIN_H-300);
-    glVertex2f(WIN_W/2+100, WIN_H-270);
-    glVertex2f(WIN_W/2-100, WIN_H-270);
-    glEnd();
-
-    // Input text (yellowish)
-    drawText(WIN_W/2-90, WIN_H-285, tempName + "_", GLUT_BITMAP_HELVETICA_18, {1,0.95f,0.45f,1});
-
-    // Instructions
-    drawText(WIN_W/2-120, WIN_H-350, "Type name and press ENTER", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-    drawText(WIN_W/2-80, WIN_H-370, "ESC to cancel", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-}
-
-void drawScoreBoard() {
-    // Background with faint vignette
-    glBegin(GL_QUADS);
-    glColor4f(0.02f, 0.05f, 0.06f, 1.0f);
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glColor4f(0.05f, 0.02f, 0.07f, 1.0f);
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    drawText(WIN_W/2-80, WIN_H-100, "SCORE BOARD", GLUT_BITMAP_TIMES_ROMAN_24, {0.9f,0.9f,0.2f,1});
-
-    // Show current selected player & best
-    drawText(WIN_W/2-260, WIN_H-150, "Current Player: " + playerName, GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-    drawText(WIN_W/2-260, WIN_H-180, "Current Round Score: " + std::to_string(score), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-    drawText(WIN_W/2-260, WIN_H-210, "Best Score (saved): " + std::to_string(playerScores[currentPlayer]), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
-
-    // Draw the global scoreboard list (sorted by score desc for display)
-    std::vector<std::pair<std::string,int>> sorted = scoreboard;
-    std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b){
-        if(a.second != b.second) return a.second > b.second; // higher first
-        return a.first < b.first;
-    });
-
-    drawText(WIN_W/2-80, WIN_H-260, "All Recorded Runs (Top entries):", GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.9f,1});
-
-    int startY = WIN_H-300;
-    int idx = 0;
-    // show up to top 12 entries
-    for(const auto &entry : sorted) {
-        if(idx >= 12) break;
-        std::string line = std::to_string(idx+1) + ". " + entry.first + "  -  " + std::to_string(entry.second);
-        drawText(WIN_W/2-160, startY - idx*24, line, GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.95f,1});
-        idx++;
-    }
-    if(sorted.empty()) {
-        drawText(WIN_W/2-140, startY, "(No recorded runs yet)", GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.95f,0.9f});
-    }
-
-    // Instructions
-    drawText(WIN_W/2-80, 80, "Press ESC to go back", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-}
-
-void drawGameScreen() {
-    // Game background gradient: deep ocean blues
-    glBegin(GL_QUADS);
-    glColor4f(0.02f, 0.06f, 0.12f, 1.0f);
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glColor4f(0.03f, 0.12f, 0.18f, 1.0f);
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    // Draw blocks (simple bricks)
-    for(const auto& b: blocks) {
-        if(b.alive) drawBrick(b);
-    }
-
-    // Draw player paddle (simple design)
-    drawPaddle(padX, padY, padW, padH);
-
-    // Draw ball (normal)
-    drawBall(ballX, ballY, ballSize);
-
-    // Draw player name above paddle
-   // drawText(padX + padW/2 - 30, padY + padH + 10, playerName, GLUT_BITMAP_9_BY_15, {0.95f,0.95f,0.95f,1});
-
-    // Draw score and lives (new small HUD box)
-    glBegin(GL_QUADS);
-    glColor4f(0.05f,0.05f,0.06f,0.65f);
-    glVertex2f(10, WIN_H-40); glVertex2f(320, WIN_H-40);
-    glVertex2f(320, WIN_H-10); glVertex2f(10, WIN_H-10);
-    glEnd();
-
-    drawText(20, WIN_H-28, "Score: " + std::to_string(score), GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.95f,1});
-    drawText(20, WIN_H-48, "Lives: " + std::to_string(lives), GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,1});
-    // additional info
-    drawText(140, WIN_H-48, "Player: " + playerName, GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,1});
-    drawText(140, WIN_H-28, "Speed: " + std::to_string((int)padSpeed), GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,1});
-
-    // Sound status in HUD
-    drawText(240, WIN_H-28, std::string("Sound: ") + (soundEnabled ? "ON" : "OFF"), GLUT_BITMAP_9_BY_15, {0.95f,0.9f,0.6f,1});
-
-    // Draw controls help
-    drawText(WIN_W-300, WIN_H-30, "Arrow Keys/Mouse: Move", GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,0.9f});
-    drawText(WIN_W-300, WIN_H-50, "SPACE: Release Ball", GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,0.9f});
-    drawText(WIN_W-300, WIN_H-70, "P: Pause", GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,0.9f});
-    drawText(WIN_W-300, WIN_H-90, "ESC: Menu | M: Toggle Sound", GLUT_BITMAP_9_BY_15, {0.9f,0.9f,0.95f,0.9f});
-}
-
-void drawGameOver() {
-    // Semi-transparent overlay
-    glBegin(GL_QUADS);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    drawText(WIN_W/2-60, WIN_H/2+20, "GAME OVER", GLUT_BITMAP_HELVETICA_18, {1,0.3f,0.3f,1});
-    drawText(WIN_W/2-80, WIN_H/2-10, "Score: " + std::to_string(score), GLUT_BITMAP_HELVETICA_18, {1,1,1,1});
-    drawText(WIN_W/2-100, WIN_H/2-40, "Press ENTER for next player", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-    drawText(WIN_W/2-80, WIN_H/2-60, "ESC for Menu", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-}
-
-void drawWinScreen() {
-    // Semi-transparent overlay
-    glBegin(GL_QUADS);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
-    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
-    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
-    glEnd();
-
-    drawText(WIN_W/2-40, WIN_H/2+20, "YOU WIN!", GLUT_BITMAP_HELVETICA_18, {0.4f,1.0f,0.6f,1});
-    drawText(WIN_W/2-80, WIN_H/2-10, "Score: " + std::to_string(score), GLUT_BITMAP_HELVETICA_18, {1,1,1,1});
-    drawText(WIN_W/2-120, WIN_H/2-40, "Press ENTER for next player", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-    drawText(WIN_W/2-100, WIN_H/2-60, "ESC for Menu", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
-}
-
-void renderScene() {
-    glClear(GL_COLOR_BUFFER_BIT);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    if(gState == GameState::MENU) {
-        switch(currentScreen) {
-            case MenuScreen::MAIN:
-                drawMainMenu();
-                break;
-            case MenuScreen::PLAYER_NAME:
-                drawPlayerNameScreen();
-                break;
-            case MenuScreen::SCORE_BOARD:
-                drawScoreBoard();
-                break;
-        }
-    } else if(gState == GameState::PLAYING) {
-        drawGameScreen();
-    } else if(gState == GameState::GAME_OVER) {
-        drawGameScreen();
-        drawGameOver();
-    } else if(gState == GameState::WIN) {
-        drawGameScreen();
-        drawWinScreen();
-    }
-
-    glutSwapBuffers();
-}
-
-bool checkCollision(float ax, float ay, float aw, float ah, float bx, float by, float bw, float bh) {
-    return ax < bx+bw && ax+aw > bx && ay < by+bh && ay+ah > by;
-}
-
-void updateBall() {
-    if(ballStuckToPaddle) {
-        ballX = padX + padW/2.0f;
-        return;
-    }
-
-    ballX += ballVX;
-    ballY += ballVY;
-
-    // Wall collision (left/right)
-    if(ballX - ballSize < 0) {
-        ballX = ballSize;
-        ballVX = -ballVX;
-    }
-    if(ballX + ballSize > WIN_W) {
-        ballX = WIN_W - ballSize;
-        ballVX = -ballVX;
-    }
-    // Top
-    if(ballY + ballSize > WIN_H) {
-        ballY = WIN_H - ballSize;
-        ballVY = -ballVY;
-    }
-
-    // Paddle collision
-    if(ballY - ballSize < padY + padH && ballY > padY &&
-       ballX > padX - ballSize && ballX < padX + padW + ballSize) {
-        ballVY = fabs(ballVY);
-        float hit = (ballX - (padX + padW/2)) / (padW/2);
-        ballVX = hit * 12.0f;
-        // nudge ball above paddle
-        ballY = padY + padH + ballSize + 1.0f;
-        // Play paddle sound (cartoon or fallback)
-        playSfxFileOrAlias(CART_PADDLE_FILE, SND_PADDLE_HIT);
-    }
-
-    // Block collision
-    for(auto &b : blocks) {
-        if(b.alive && checkCollision(ballX-ballSize, ballY-ballSize, ballSize*2, ballSize*2, b.x, b.y, b.w, b.h)) {
-            b.alive = false;
-            // reflect based on hit: if hit on sides, change vx else vy
-            float overlapLeft = (ballX+ballSize) - b.x;
-            float overlapRight = (b.x + b.w) - (ballX-ballSize);
-            float overlapTop = (b.y + b.h) - (ballY-ballSize);
-            float overlapBottom = (ballY+ballSize) - b.y;
-            float minOverlap = std::min({overlapLeft, overlapRight, overlapTop, overlapBottom});
-            if(minOverlap == overlapLeft || minOverlap == overlapRight) {
-                ballVX = -ballVX;
-            } else {
-                ballVY = -ballVY;
-            }
-
-            score += 10;
-            playSfxFileOrAlias(CART_HIT_FILE, SND_HIT_BRICK);
-            break;
-        }
-    }
-
-    // Bottom boundary
-    if(ballY - ballSize < 0) {
-        lives--;
-        playSfxFileOrAlias(CART_LOSE_FILE, SND_LOSE_LIFE);
-        if(lives > 0) {
-            resetBallOnPaddle();
-        } else {
-            // Round ended by losing all lives -> record run once, update best, and go to GAME_OVER
-            saveBestForCurrentPlayer();
-            recordScoreboardEntryIfNeeded();
-            gState = GameState::GAME_OVER;
-        }
-    }
-
-    // Check win condition
-    bool blocksLeft = false;
-    for(auto &b : blocks) {
-        if(b.alive) { blocksLeft = true; break; }
-    }
-    if(!blocksLeft) {
-        // Round ended by clearing all blocks -> record run once, update best, and go to WIN
-        saveBestForCurrentPlayer();
-        recordScoreboardEntryIfNeeded();
-        gState = GameState::WIN;
-        playSfxFileOrAlias(CART_WIN_FILE, SND_GAME_WIN);
-    }
-}
-
-void update(int) {
-    // update pulse for menu highlight
-    menuPulse += 0.08f;
-    if(menuPulse > 10000.0f) menuPulse = 0.0f;
-
-    if(gState == GameState::PLAYING) {
-        updateBall();
-    }
-    glutPostRedisplay();
-    glutTimerFunc(16, update, 0);
-}
-
-void handleMenuAction() {
-    switch(menuSelection) {
-        case 0: // START GAME
-            gState = GameState::PLAYING;
-            resetLevel();
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-            break;
-        case 1: // PLAYER NAME
-            currentScreen = MenuScreen::PLAYER_NAME;
-            tempName = playerName;
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-            break;
-        case 2: // SCORE BOARD
-            saveBestForCurrentPlayer();
-            currentScreen = MenuScreen::SCORE_BOARD;
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-            break;
-        case 3: // EXIT
-            exit(0);
-            break;
-    }
-}
-
-void keyboard(unsigned char key, int, int) {
-    if(gState == GameState::MENU) {
-
-        // Name entry screen input
-        if(currentScreen == MenuScreen::PLAYER_NAME) {
-            if(key == 13) { // ENTER
-                if(!tempName.empty()) {
-                    playerName = tempName;
-                    playerNames[currentPlayer] = tempName;
-                }
-                currentScreen = MenuScreen::MAIN;
-                playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-            } else if(key == 27) { // ESC
-                currentScreen = MenuScreen::MAIN;
-                playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-            } else if(key == 8) { // BACKSPACE
-                if(!tempName.empty()) tempName.pop_back();
-            } else if(key >= 32 && key <= 126) { // Printable characters
-                if(tempName.length() < 15) tempName += key;
-            }
-            return;
-        }
-
-        // Generic ESC = Back for submenus (e.g., SCORE_BOARD)
-        if(key == 27) {
-            if(currentScreen != MenuScreen::MAIN) {
-                currentScreen = MenuScreen::MAIN;
-                playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-                return;
-            }
-        }
-
-        // Main menu navigation
-        if(key >= '1' && key <= '4') {
-            menuSelection = key - '1';
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        } else if(key == 13) { // ENTER
-            handleMenuAction();
-        } else if(key == 'm' || key == 'M') { // toggle sound
-            soundEnabled = !soundEnabled;
-            // Play a tiny menu sound only if enabling sound (to confirm). If disabling, obviously don't play.
-            if(soundEnabled) playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        }
-    } else if(gState == GameState::PLAYING) {
-        if(key == 27) { // ESC to menu
-            saveBestForCurrentPlayer();
-            gState = GameState::MENU;
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        } else if(key == ' ') { // SPACE to release ball
-            ballStuckToPaddle = false;
-        } else if(key == 'p' || key == 'P') {
-            // Pause can be added here
-        } else if(key == 'm' || key == 'M') { // sound toggle while playing
-            soundEnabled = !soundEnabled;
-            if(soundEnabled) playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        }
-    } else if(gState == GameState::GAME_OVER || gState == GameState::WIN) {
-        if(key == 13) { // ENTER
-            // Ensure best saved and scoreboard entry recorded (should already be), then progress to next player + new round
-            saveBestForCurrentPlayer();
-            recordScoreboardEntryIfNeeded();
-            nextPlayer();
-            gState = GameState::PLAYING;
-            resetLevel();
-        } else if(key == 27) { // ESC to menu
-            saveBestForCurrentPlayer();
-            recordScoreboardEntryIfNeeded();
-            gState = GameState::MENU;
-            playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        } else if(key == 'm' || key == 'M') {
-            soundEnabled = !soundEnabled;
-            if(soundEnabled) playSfxFileOrAlias(CART_MENU_FILE, SND_MENU_NAV);
-        }
-    }
-}
-
-void specialKeys(int key, int, int) {
-    if(gState != GameState::PLAYING) return;
-    switch(key) {
-        case GLUT_KEY_LEFT:
-            padX -= padSpeed;
-            if(padX < 10) padX = 10;
-            break;
-        case GLUT_KEY_RIGHT:
-            padX += padSpeed;
-            if(padX > WIN_W - padW - 10) padX = WIN_W - padW - 10;
-            break;
-    }
-}
-
-void mouseMotion(int x, int y) {
-    if(gState == GameState::PLAYING) {
-        padX = x - padW/2;
-        if(padX < 10) padX = 10;
-        if(padX > WIN_W - padW - 10) padX = WIN_W - padW - 10;
-    }
-}
-
-void mouseClick(int button, int state, int, int) {
-    if(gState == GameState::PLAYING && button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
-        ballStuckToPaddle = false;
-    }
-}
-
-void reshape(int w, int h) {
-    glViewport(0, 0, w, h);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluOrtho2D(0, WIN_W, 0, WIN_H);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-}
-
-int main(int argc, char** argv) {
-    std::srand((unsigned)std::time(nullptr));
-
-    glutInit(&argc, argv);
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA);
-    glutInitWindowSize(WIN_W, WIN_H);
-    glutCreateWindow("DX Ball");
-
-    glutDisplayFunc(renderScene);
-    glutKeyboardFunc(keyboard);
-    glutSpecialFunc(specialKeys);
-    glutPassiveMotionFunc(mouseMotion);
-    glutMouseFunc(mouseClick);
-    glutReshapeFunc(reshape);
-    glutTimerFunc(16, update, 0);
-
-    // Initialize game
-    playerName = playerNames[currentPlayer];
-    resetLevel();
-
-    // Print to console about sound files presence (helpful for debugging)
-    std::cout << "Sound enabled: " << (soundEnabled ? "YES" : "NO") << "\n";
-    std::cout << "cartoon_hit.wav present: " << (fileExists(CART_HIT_FILE) ? "YES" : "NO") << "\n";
-    std::cout << "cartoon_paddle.wav present: " << (fileExists(CART_PADDLE_FILE) ? "YES" : "NO") << "\n";
-    std::cout << "cartoon_lose.wav present: " << (fileExists(CART_LOSE_FILE) ? "YES" : "NO") << "\n";
-    std::cout << "cartoon_win.wav present: " << (fileExists(CART_WIN_FILE) ? "YES" : "NO") << "\n";
-    std::cout << "cartoon_menu.wav present: " << (fileExists(CART_MENU_FILE) ? "YES" : "NO") << "\n";
-    std::cout << "If you want cartoon sounds, place the above .wav files next to the executable.\n";
-
-    glutMainLoop();
-    return 0;
-}
+// dxball_normal_ball_updated_ui.cpp
+#include <GL/glut.h>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <future>
+#include "game_world.h"
+#include "sim_clock.h"
+#include "render_batch.h"
+#include "renderer_gl.h"
+#include "text_renderer_gl.h"
+#include "asset_pack.h"
+#include "audio.h"
+#include "replay.h"
+#include "score_log.h"
+#include "level.h"
+#include "profiler.h"
+#include "input.h"
+#include "versus.h"
+#include "particles.h"
+#include "frame_arena.h"
+#include "board_set.h"
+
+#ifdef _WIN32
+#pragma comment(lib, "winmm.lib")
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+enum class GameState { MENU, PLAYING, GAME_OVER, WIN };
+enum class MenuScreen { MAIN, PLAYER_NAME, SCORE_BOARD };
+
+static GameState gState = GameState::MENU;
+static MenuScreen currentScreen = MenuScreen::MAIN;
+static int menuSelection = 0;
+
+// Player info
+static int currentPlayer = 0;
+static std::string playerNames[3] = {"Player1", "Player2", "Player3"};
+static std::string playerName = playerNames[currentPlayer];
+static bool nameInputMode = false;
+static std::string tempName = "";
+
+// Per-player best scores
+static int playerScores[3] = {0, 0, 0};
+
+// Global scoreboard: every finished run and best goes to an append-only log on
+// disk (scores.dxl, written on a background thread); the menu shows a top-12
+// board kept sorted as runs come in
+static ScoreLog scoreLog;
+static TopScores scoreboard(12);
+static std::string scoreLogPath = "scores.dxl";
+
+// Flag to ensure a round's score is recorded only once
+static bool scoreRecordedThisRound = false;
+
+// Gameplay: paddle, balls, power-ups, bricks, score and lives live in the headless world
+static GameWorld world;
+// Key/mouse state from the GLUT callbacks, sampled at the start of every tick
+static InputState input;
+// Fixed-step driver: simulation rate is independent of the display rate
+static FixedStepClock simClock;
+// Every round is recorded (seed, level, per-tick input) and written out when
+// it ends, so it can be re-simulated with tools/dxreplay
+static ReplayRecorder recorder;
+static SimRng sessionRng;
+static std::string replayPath = "last_round.dxr";
+
+// Level rotation (--levels a,b,...; "RxC" is a generated wall). Clearing a
+// level moves on to the next one. When a round ends the next round's level
+// is parsed and gridded on a worker so ENTER starts it without a stall.
+static std::vector<std::string> levelNames = {"4x8"};
+static PhysicsMode physicsMode = PhysicsMode::FLOAT;   // --physics; versus peers must agree
+static size_t levelIndex = 0;
+struct LevelPreload {
+    std::string name;
+    std::future<std::unique_ptr<PreparedLevel>> result;
+};
+static LevelPreload levelPreload;
+
+// Batched rendering: level bricks are built once per round, ball and paddle
+// come from cached meshes re-positioned every frame
+static GLBatchRenderer batchRenderer;
+static BrickMesh brickMesh;
+static ShapeMeshes shapeMeshes;
+static RenderBatch frameBatch;
+static RenderStats renderStats, lastFrameStats;
+static bool showRenderStats = false;
+
+// Debris and sparks: front-end only, updated once per displayed frame
+static ParticlePool particles;
+static std::vector<RenderVertex> particlePoints;
+static const float PARTICLE_SIZE = 3.0f;
+
+// Text: glyph atlas built on the first frame; HUD labels are laid out again
+// only when the value they show changes
+static GLTextRenderer textRenderer;
+static TextLabel hudScore, hudLives, hudPlayer, hudSpeed, hudSound, hudHelp[4], hudStats;
+
+// Versus (--versus): this peer's board is `world`; the rival's board is
+// simulated alongside it from the rival's inputs, with rollback when a
+// predicted input turns out wrong (versus.h). Each START GAME is one match
+// on the first --levels entry; the session waits until the other side starts.
+static bool versusMode = false;
+static VersusConfig versusCfg;
+static uint64_t versusSeed = 1;
+static uint32_t versusMatch = 0;
+static VersusPeer versusPeer;
+static GameWorld rivalWorld;
+static double versusLastSend = 0.0;
+static uint64_t versusStalls = 0;
+static RenderBatch rivalBatch;
+static TextLabel hudRival, hudRivalNet;
+
+// Multi-board (--boards N): N rounds at once in tiled viewports, one board
+// per player. The first --board-players boards are played from the keyboard
+// (arrows/mouse/SPACE, A/D/W, J/L/K); the rest run the autopilot. Boards
+// step on a thread pool and meet at a barrier before the frame is drawn.
+// These rounds are not recorded as replays.
+static bool multiBoard = false;
+static uint32_t boardCount = 1;
+static uint32_t boardPlayers = 1;
+static unsigned boardThreads = 0;            // --board-threads; 0 = one per core
+static BoardSet boardSet;
+static InputState boardInput[2];             // second and third player
+static RenderBatch boardBatch;
+static std::vector<TextLabel> boardLabels;
+static TextLabel hudBoards;
+static const float BOARD_STRIP = 26.0f;      // status line above the tiles
+
+// Frame profiler: F toggles the overlay, T starts/stops a chrome://tracing capture
+static FrameProfiler frameProfiler;
+static bool showProfiler = false;
+static std::string tracePath = "frame_trace.json";
+static uint32_t soundsThisFrame = 0;
+static RenderBatch overlayBatch;
+
+// Transient per-frame strings come from the arena (reset at the start of
+// every frame). --alloc-check warn|abort reports steady frames that still
+// hit the heap; screen changes, new rounds and typed keys restart the warmup.
+static FrameArena frameArena;
+static AllocWatch allocWatch;
+static bool allocCheck = false;
+static bool frameUnsettled = true;
+
+// Frames on demand: outside play only the menu highlight moves, so the idle
+// callback is dropped and frames are drawn after input or a state change,
+// plus the highlight pulse at menuPulseHz. GLUT then blocks in its event
+// loop and the process sleeps between events.
+static bool continuousFrames = false;
+static bool pulseTimerArmed = false;
+static double menuPulseHz = 15.0;    // --menu-fps; 0 keeps the highlight still
+
+// ------------------- SOUND (UPDATED) -------------------
+// Behavior:
+// - cartoon_*.wav sounds are taken from the asset pack (dxball.pak, built with
+//   tools/dxpack) or, without a pack, from loose files next to the exe:
+//     cartoon_hit.wav, cartoon_paddle.wav, cartoon_lose.wav, cartoon_win.wav, cartoon_menu.wav
+//   Packed sounds already in the mixer format are played straight from the mapping.
+// - The game only posts sound events to the mixer thread (audio.h), so no disk or
+//   OS calls happen on the physics path and overlapping sounds mix instead of cutting off.
+// - If a file is not present, the mixer falls back to the Windows system alias below.
+// - Press 'M' to toggle sound ON/OFF. Sound state shown in HUD/footer.
+// - If sound is disabled, no events are posted.
+// - --audio null / --audio wav:<file> choose another output (headless runs).
+
+static bool soundEnabled = true;
+static AudioEngine audio;
+// Mapped for the whole run: the audio engine may reference its sounds in place
+static AssetPack assets;
+
+// External filenames (place your .wav files next to exe to use them) and
+// fallback aliases (Windows)
+struct SoundFile { SoundId id; const char* file; const char* alias; };
+static const SoundFile SOUND_FILES[] = {
+    {SoundId::HIT,    "cartoon_hit.wav",    "SystemAsterisk"},
+    {SoundId::PADDLE, "cartoon_paddle.wav", "SystemExclamation"},
+    {SoundId::LOSE,   "cartoon_lose.wav",   "SystemHand"},
+    {SoundId::WIN,    "cartoon_win.wav",    "SystemExit"},
+    {SoundId::MENU,   "cartoon_menu.wav",   "SystemStart"},
+};
+
+#ifdef _WIN32
+// Runs on the mixer thread when a cartoon file wasn't loaded
+static void playAliasFallback(SoundId id) {
+    for(const auto& s : SOUND_FILES) {
+        if(s.id == id) PlaySoundA(s.alias, NULL, SND_ASYNC | SND_ALIAS);
+    }
+}
+#endif
+
+// Queue a sound for the mixer. If sound disabled, do nothing.
+inline void playSfx(SoundId id) {
+    if(!soundEnabled) return;
+    audio.post(id);
+    soundsThisFrame++;
+}
+// --------------------------------------------
+
+void drawText(float x, float y, const char* s, void* font = GLUT_BITMAP_HELVETICA_18, Color c = {1,1,1,1}) {
+    textRenderer.drawText(x, y, s, font, c, renderStats);
+}
+
+void drawLabel(const TextLabel& label, void* font) {
+    textRenderer.drawLabel(label, font, renderStats);
+}
+
+// Book-keeping for the remaining immediate-mode glBegin/glEnd blocks
+inline void countImmediate(uint32_t verts) {
+    renderStats.drawCalls++;
+    renderStats.vertices += verts;
+}
+
+// Keep `score` as player `slot`'s best if it beats it
+void saveBest(int slot, const std::string& name, int score) {
+    if(slot < 0 || slot >= 3 || score <= playerScores[slot]) return;
+    playerScores[slot] = score;
+    ScoreRecord r;
+    r.kind = ScoreKind::BEST;
+    r.slot = uint8_t(slot);
+    r.score = score;
+    r.name = name;
+    scoreLog.append(r);
+}
+
+// A finished run goes on the scoreboard and into the log
+void recordRun(int slot, const std::string& name, int score) {
+    scoreboard.insert(name, score);
+    ScoreRecord r;
+    r.kind = ScoreKind::RUN;
+    r.slot = uint8_t(slot);
+    r.score = score;
+    r.name = name;
+    scoreLog.append(r);
+}
+
+// Update best score for currentPlayer (keeps per-player best)
+void saveBestForCurrentPlayer() {
+    saveBest(currentPlayer, playerName, world.score);
+}
+
+// Record this finished round (name,score) into the global scoreboard once per round
+void recordScoreboardEntryIfNeeded() {
+    if(scoreRecordedThisRound) return;
+    if(playerName.empty()) return;
+    recordRun(currentPlayer, playerName, world.score);
+    scoreRecordedThisRound = true;
+}
+
+// Rebuild the board and per-player bests from the log at startup
+void loadScoreRecord(const ScoreRecord& r) {
+    if(r.kind == ScoreKind::RUN) scoreboard.insert(r.name, r.score);
+    if(r.slot < 3) playerScores[r.slot] = std::max(playerScores[r.slot], int(r.score));
+}
+
+// Write the current round's replay (once per round)
+void saveReplayIfRecording() {
+    if(!recorder.active() || replayPath.empty()) return;
+    if(!saveReplay(replayPath.c_str(), recorder.replay())) std::cout << "Could not write replay " << replayPath << "\n";
+    recorder = ReplayRecorder();
+}
+
+static bool isGeneratedLevel(const std::string& name) {
+    int rows, cols;
+    char tail;
+    return std::sscanf(name.c_str(), "%dx%d%c", &rows, &cols, &tail) == 2;
+}
+
+// Start preparing `name` in the background. Pack entries are fetched here (the
+// pack isn't thread-safe); the worker only parses bytes that stay mapped.
+void preloadLevel(const std::string& name) {
+    if(isGeneratedLevel(name) || levelPreload.name == name) return;
+    AssetView view;
+    bool packed = assets.isOpen() && assets.get(name.c_str(), view);
+    levelPreload.name = name;
+    levelPreload.result = std::async(std::launch::async, [name, packed, view]() {
+        std::unique_ptr<PreparedLevel> level(new PreparedLevel());
+        std::string error;
+        bool ok = packed ? prepareLevel(view.data, view.size, 0.0f, float(WIN_H), *level, error)
+                         : prepareLevelFile(name, 0.0f, float(WIN_H), *level, error);
+        if(!ok) {
+            std::cout << "Level " << name << ": " << error << "\n";
+            level.reset();
+        }
+        return level;
+    });
+}
+
+// The prepared level for `name`, waiting for the preload if one is running
+std::unique_ptr<PreparedLevel> takeLevel(const std::string& name) {
+    preloadLevel(name);
+    std::unique_ptr<PreparedLevel> level;
+    if(levelPreload.name == name && levelPreload.result.valid()) level = levelPreload.result.get();
+    levelPreload = LevelPreload();
+    return level;
+}
+
+// Both boards from the shared seed and default tuning, then a new session
+void startVersusMatch() {
+    versusPeer.close();
+    versusMatch++;
+    versusCfg.seed = versusSeed + versusMatch;
+    int local = versusCfg.localPlayer;
+    GameWorld* boards[2];
+    boards[local] = &world;
+    boards[1 - local] = &rivalWorld;
+    ReplayHeader headers[2];
+    for(int p=0; p<2; p++) {
+        headers[p].seed = versusCfg.seed * 2 + uint64_t(p);
+        headers[p].level = levelNames[0];
+        headers[p].stepSeconds = float(simClock.dt);
+        headers[p].physics = physicsMode;
+        if(!setupReplayWorld(headers[p], *boards[p])) {
+            std::cout << "Versus: level " << levelNames[0] << " can't be loaded, using 4x8\n";
+            headers[p].level = "4x8";
+            setupReplayWorld(headers[p], *boards[p]);
+        }
+    }
+    std::string error;
+    if(!versusPeer.open(versusCfg, boards[0], boards[1], float(simClock.dt), error)) {
+        std::cout << "Versus: " << error << "; playing alone\n";
+        versusMode = false;
+    }
+    recorder.begin(headers[local]);
+    brickMesh.build(world.bricks);
+    shapeMeshes.build(world.padW, world.padH);
+    particles.clear();
+    input.clear();
+    frameUnsettled = true;
+    scoreRecordedThisRound = false;
+    versusStalls = 0;
+}
+
+// Every board on the current level with its own seed
+void startBoards() {
+    boardSet.resize(boardCount, boardThreads);
+    boardLabels.resize(boardCount);
+    ReplayHeader h;
+    h.level = levelNames[levelIndex];
+    h.stepSeconds = float(simClock.dt);
+    h.padSpeed = world.padSpeed;
+    h.paddleDeflect = world.paddleDeflect;
+    h.powerUpChance = world.powerUpChance;
+    h.physics = physicsMode;
+    std::unique_ptr<PreparedLevel> prepared;
+    if(!isGeneratedLevel(h.level)) {
+        prepared = takeLevel(h.level);
+        if(prepared && h.physics == PhysicsMode::FIXED && !fitsFixedPoint(prepared->bricks)) {
+            std::cout << "Level " << h.level << " is too big for fixed-point physics, using 4x8\n";
+            prepared.reset();
+        }
+        if(!prepared) h.level = "4x8";
+    }
+    for(uint32_t i=0; i<boardSet.size(); i++) {
+        Board& b = boardSet[i];
+        h.seed = sessionRng.next();
+        // each board consumes its own copy of the prepared level
+        std::unique_ptr<PreparedLevel> copy(prepared ? new PreparedLevel(*prepared) : nullptr);
+        setupReplayWorld(h, b.world, copy.get());
+        b.autopilot = i >= boardPlayers;
+        b.pilotRng.seed(h.seed ^ 0xA5A5A5A5ull);
+    }
+    particles.clear();
+    input.clear();
+    for(InputState& in : boardInput) in.clear();
+    frameUnsettled = true;
+}
+
+// Reset a level / start a new round
+void resetLevel() {
+    if(versusMode) {
+        startVersusMatch();
+        return;
+    }
+    if(multiBoard) {
+        startBoards();
+        return;
+    }
+    ReplayHeader h;
+    h.seed = sessionRng.next();
+    h.level = levelNames[levelIndex];
+    h.stepSeconds = float(simClock.dt);
+    h.padSpeed = world.padSpeed;
+    h.paddleDeflect = world.paddleDeflect;
+    h.powerUpChance = world.powerUpChance;
+    h.physics = physicsMode;
+    std::unique_ptr<PreparedLevel> prepared;
+    if(!isGeneratedLevel(h.level)) {
+        prepared = takeLevel(h.level);
+        if(prepared && h.physics == PhysicsMode::FIXED && !fitsFixedPoint(prepared->bricks)) {
+            std::cout << "Level " << h.level << " is too big for fixed-point physics, using 4x8\n";
+            prepared.reset();
+        }
+        if(!prepared) h.level = "4x8";
+    }
+    setupReplayWorld(h, world, prepared.get());
+    recorder.begin(h);
+    brickMesh.build(world.bricks);
+    shapeMeshes.build(world.padW, world.padH);
+    particles.clear();
+    input.clear();
+    frameUnsettled = true;
+    scoreRecordedThisRound = false;
+}
+
+void nextPlayer() {
+    currentPlayer = (currentPlayer + 1) % 3;
+    playerName = playerNames[currentPlayer];
+    world.padSpeed += 2.0f;
+    resetLevel();
+}
+
+void drawMainMenu() {
+    // New background gradient: dark teal -> deep purple
+    glBegin(GL_QUADS);
+    glColor4f(0.02f, 0.08f, 0.10f, 1.0f); // bottom
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glColor4f(0.08f, 0.02f, 0.12f, 1.0f); // top
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    // Title with a new color (soft cyan)
+    drawText(WIN_W/2-100, WIN_H-100, "DX BALL", GLUT_BITMAP_TIMES_ROMAN_24, {0.55f,0.95f,0.98f,1});
+
+    // Menu options
+    const char* menuItems[] = {
+        "1. START GAME",
+        frameArena.format("2. PLAYER NAME: %s", playerName.c_str()),
+        "3. SCORE BOARD",
+        "4. EXIT"
+    };
+
+    for(int i=0; i<4; i++) {
+        // pulsing highlight for selected option
+        Color c;
+        if(i == menuSelection) {
+            float phase = float(std::fmod(monotonicSeconds() * 5.0, 6.2831853));
+            float pulse = 0.6f + 0.4f * (0.5f * (1.0f + sinf(phase))); // between 0.6 and 1.0
+            c = Color{pulse*0.6f, pulse*0.95f, 1.0f, 1.0f}; // cyan-ish highlight
+        } else {
+            c = Color{0.9f,0.9f,0.95f,1};
+        }
+        drawText(WIN_W/2-120, WIN_H-180-i*50, menuItems[i], GLUT_BITMAP_HELVETICA_18, c);
+    }
+
+    // Small footer lines (subtle) + sound status
+    const char* footer = "Use NUMBER KEYS 1-4 to select menu  |  ENTER to confirm  |  ESC to go back";
+    drawText(WIN_W/2-210, 110, footer, GLUT_BITMAP_9_BY_15, {0.7f,0.8f,0.9f,0.7f});
+
+    const char* soundStatus = soundEnabled ? "Sound: ON (Press M to mute)" : "Sound: OFF (Press M to unmute)";
+    drawText(WIN_W/2-160, 80, soundStatus, GLUT_BITMAP_9_BY_15, {0.8f,0.85f,1.0f,0.9f});
+}
+
+void drawPlayerNameScreen() {
+    // Background: slightly lighter than main menu
+    glBegin(GL_QUADS);
+    glColor4f(0.03f, 0.06f, 0.08f, 1.0f);
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glColor4f(0.06f, 0.03f, 0.09f, 1.0f);
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    drawText(WIN_W/2-150, WIN_H-100, "CHANGE PLAYER NAME", GLUT_BITMAP_TIMES_ROMAN_24, {0.9f,0.7f,0.2f,1});
+
+    // Current player info
+    drawText(WIN_W/2-100, WIN_H-160, frameArena.format("Current Player: %s", playerName.c_str()), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+    drawText(WIN_W/2-120, WIN_H-200, frameArena.format("Player %d of 3", currentPlayer+1), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+
+    // Name input
+    drawText(WIN_W/2-80, WIN_H-260, "Enter new name:", GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+
+    // Input box (accented)
+    glBegin(GL_QUADS);
+    glColor4f(0.15f, 0.15f, 0.22f, 0.95f);
+    glVertex2f(WIN_W/2-100, WIN_H-300);
+    glVertex2f(WIN_W/2+100, WIN_H-300);
+    glVertex2f(WIN_W/2+100, WIN_H-270);
+    glVertex2f(WIN_W/2-100, WIN_H-270);
+    glEnd();
+    countImmediate(4);
+
+    // Input text (yellowish)
+    drawText(WIN_W/2-90, WIN_H-285, frameArena.format("%s_", tempName.c_str()), GLUT_BITMAP_HELVETICA_18, {1,0.95f,0.45f,1});
+
+    // Instructions
+    drawText(WIN_W/2-120, WIN_H-350, "Type name and press ENTER", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+    drawText(WIN_W/2-80, WIN_H-370, "ESC to cancel", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+}
+
+void drawScoreBoard() {
+    // Background with faint vignette
+    glBegin(GL_QUADS);
+    glColor4f(0.02f, 0.05f, 0.06f, 1.0f);
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glColor4f(0.05f, 0.02f, 0.07f, 1.0f);
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    drawText(WIN_W/2-80, WIN_H-100, "SCORE BOARD", GLUT_BITMAP_TIMES_ROMAN_24, {0.9f,0.9f,0.2f,1});
+
+    // Show current selected player & best
+    drawText(WIN_W/2-260, WIN_H-150, frameArena.format("Current Player: %s", playerName.c_str()), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+    drawText(WIN_W/2-260, WIN_H-180, frameArena.format("Current Round Score: %d", world.score), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+    drawText(WIN_W/2-260, WIN_H-210, frameArena.format("Best Score (saved): %d", playerScores[currentPlayer]), GLUT_BITMAP_HELVETICA_18, {0.95f,0.95f,0.95f,1});
+
+    // Draw the global scoreboard list (already kept sorted by score desc)
+    const std::vector<ScoreEntry>& sorted = scoreboard.entries();
+
+    drawText(WIN_W/2-80, WIN_H-260, "All Recorded Runs (Top entries):", GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.9f,1});
+
+    int startY = WIN_H-300;
+    int idx = 0;
+    // show up to top 12 entries
+    for(const auto &entry : sorted) {
+        if(idx >= 12) break;
+        const char* line = frameArena.format("%d. %s  -  %d", idx+1, entry.name.c_str(), entry.score);
+        drawText(WIN_W/2-160, startY - idx*24, line, GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.95f,1});
+        idx++;
+    }
+    if(sorted.empty()) {
+        drawText(WIN_W/2-140, startY, "(No recorded runs yet)", GLUT_BITMAP_HELVETICA_18, {0.9f,0.9f,0.95f,0.9f});
+    }
+
+    // Instructions
+    drawText(WIN_W/2-80, 80, "Press ESC to go back", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+}
+
+// A whole board shrunk by `scale` with its bottom-left corner at (left,
+// bottom), as plain rectangles: the versus rival and the multi-board tiles
+void appendBoardTile(RenderBatch& out, const GameWorld& w, float left, float bottom, float scale, float alpha) {
+    out.rect(left, bottom, left + WIN_W * scale, bottom + WIN_H * scale, {0.0f, 0.0f, 0.0f, 0.55f});
+    const BrickStore& b = w.bricks;
+    for(uint32_t i : w.aliveBricks) {
+        out.rect(left + b.x[i] * scale, bottom + b.y[i] * scale, left + (b.x[i] + b.w[i]) * scale,
+                 bottom + (b.y[i] + b.h[i]) * scale, b.palette[b.paletteIndex[i]]);
+    }
+    float padX = w.renderPadX(alpha);
+    out.rect(left + padX * scale, bottom + w.padY * scale, left + (padX + w.padW) * scale,
+             bottom + (w.padY + w.padH) * scale, {0.85f, 0.85f, 0.95f, 1.0f});
+    for(uint32_t i=0; i<w.balls.count; i++) {
+        float x = left + w.renderBallX(i, alpha) * scale, y = bottom + w.renderBallY(i, alpha) * scale;
+        float rad = std::max(1.5f, w.balls.r[i] * scale);
+        out.rect(x - rad, y - rad, x + rad, y + rad, {1.0f, 0.9f, 0.4f, 1.0f});
+    }
+    const PowerUpPool& pu = w.powerUps;
+    for(uint32_t i=0; i<pu.count; i++) {
+        out.rect(left + pu.x[i] * scale, bottom + pu.y[i] * scale, left + (pu.x[i] + POWERUP_W) * scale,
+                 bottom + (pu.y[i] + POWERUP_H) * scale, {0.95f, 0.75f, 0.15f, 1.0f});
+    }
+}
+
+// The rival's board at quarter scale under the help text
+void drawRivalBoard() {
+    const float scale = 0.25f, left = WIN_W - 10 - WIN_W * scale, bottom = WIN_H - 110 - WIN_H * scale;
+    const GameWorld& r = rivalWorld;
+    rivalBatch.clear();
+    appendBoardTile(rivalBatch, r, left, bottom, scale, 1.0f);
+    batchRenderer.drawDynamic(rivalBatch, renderStats);
+
+    const FontMetrics& small = textRenderer.metrics(GLUT_BITMAP_9_BY_15);
+    const RollbackSession& s = versusPeer.session();
+    char line[96];
+    if(!versusPeer.heardFromRemote()) std::snprintf(line, sizeof(line), "Rival: waiting...");
+    else std::snprintf(line, sizeof(line), "Rival: %d  Lives: %d", r.score, r.lives);
+    hudRival.set(small, left + 4, bottom + 6, line, {0.95f,0.9f,0.6f,1});
+    std::snprintf(line, sizeof(line), "RB %llu max %u stall %llu%s", (unsigned long long)s.stats().rollbacks,
+                  s.stats().maxDepth, (unsigned long long)versusStalls, s.desyncFrame() >= 0 ? " DESYNC" : "");
+    hudRivalNet.set(small, left + 4, bottom + WIN_H * scale - 16, line, {0.7f,0.8f,0.9f,0.9f});
+    drawLabel(hudRival, GLUT_BITMAP_9_BY_15);
+    drawLabel(hudRivalNet, GLUT_BITMAP_9_BY_15);
+}
+
+// Where board i sits in multi-board play: the tiles fill the window under
+// the status line, in as square a grid as the board count allows
+struct BoardTile { float left, bottom, scale; };
+
+BoardTile boardTile(uint32_t i) {
+    uint32_t n = std::max(1u, boardSet.size());
+    uint32_t cols = uint32_t(std::ceil(std::sqrt(double(n))));
+    uint32_t rows = (n + cols - 1) / cols;
+    float cellW = float(WIN_W) / cols, cellH = (WIN_H - BOARD_STRIP) / rows;
+    BoardTile t;
+    t.scale = std::min((cellW - 6.0f) / WIN_W, (cellH - 6.0f) / WIN_H);
+    t.left = (i % cols) * cellW + (cellW - WIN_W * t.scale) * 0.5f;
+    t.bottom = (WIN_H - BOARD_STRIP) - (i / cols + 1) * cellH + (cellH - WIN_H * t.scale) * 0.5f;
+    return t;
+}
+
+const char* boardName(uint32_t i) {
+    return i < boardPlayers ? playerNames[i].c_str() : frameArena.format("CPU %u", i + 1);
+}
+
+// Every board as one batch, then a label per tile and the status line
+void drawBoards() {
+    PROFILE_SCOPE("draw.boards");
+    float alpha = (gState == GameState::PLAYING) ? simClock.alpha() : 1.0f;
+    boardBatch.clear();
+    for(uint32_t i=0; i<boardSet.size(); i++) {
+        BoardTile t = boardTile(i);
+        appendBoardTile(boardBatch, boardSet[i].world, t.left, t.bottom, t.scale, alpha);
+    }
+    batchRenderer.drawDynamic(boardBatch, renderStats);
+    particles.build(particlePoints);
+    batchRenderer.drawPoints(particlePoints, 2.0f, renderStats);
+
+    const FontMetrics& small = textRenderer.metrics(GLUT_BITMAP_9_BY_15);
+    for(uint32_t i=0; i<boardSet.size(); i++) {
+        const GameWorld& w = boardSet[i].world;
+        BoardTile t = boardTile(i);
+        const char* state = w.round == RoundState::CLEARED ? "  CLEARED" : (w.round == RoundState::LOST ? "  OUT" : "");
+        Color c = i < boardPlayers ? Color{0.95f,0.9f,0.6f,1} : Color{0.75f,0.8f,0.9f,0.9f};
+        boardLabels[i].set(small, t.left + 4, t.bottom + WIN_H * t.scale - 14,
+                           frameArena.format("%s  %d  x%d%s", boardName(i), w.score, w.lives, state), c);
+        drawLabel(boardLabels[i], GLUT_BITMAP_9_BY_15);
+    }
+    hudBoards.set(small, 10, WIN_H - 18,
+                  frameArena.format("%u boards on %u threads   sim %.1f ms/frame, slowest board %.1f ms", boardSet.size(),
+                                    boardSet.threads(), boardSet.lastAdvanceMs(), boardSet.slowestBoardMs()),
+                  {0.7f,0.8f,0.9f,0.9f});
+    drawLabel(hudBoards, GLUT_BITMAP_9_BY_15);
+}
+
+void drawGameScreen() {
+    PROFILE_SCOPE("draw.game");
+    // Game background gradient: deep ocean blues
+    glBegin(GL_QUADS);
+    glColor4f(0.02f, 0.06f, 0.12f, 1.0f);
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glColor4f(0.03f, 0.12f, 0.18f, 1.0f);
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    if(multiBoard) {
+        drawBoards();
+        return;
+    }
+
+    // Draw blocks (simple bricks): one static mesh for the whole level
+    {
+        PROFILE_SCOPE("draw.bricks");
+        batchRenderer.drawBricks(brickMesh, renderStats);
+    }
+    {
+        PROFILE_SCOPE("draw.particles");
+        particles.build(particlePoints);
+        batchRenderer.drawPoints(particlePoints, PARTICLE_SIZE, renderStats);
+    }
+
+    // Draw player paddle, balls and falling power-ups between the last two simulated states
+    PROFILE_SCOPE("draw.dynamic");
+    float alpha = (gState == GameState::PLAYING) ? simClock.alpha() : 1.0f;
+    frameBatch.clear();
+    shapeMeshes.appendPaddle(frameBatch, world.renderPadX(alpha), world.padY);
+    for(uint32_t i=0; i<world.balls.count; i++) {
+        shapeMeshes.appendBall(frameBatch, world.renderBallX(i, alpha), world.renderBallY(i, alpha), world.balls.r[i]);
+    }
+    const PowerUpPool& pu = world.powerUps;
+    for(uint32_t i=0; i<pu.count; i++) {
+        float px = pu.x[i], py = pu.y[i];
+        frameBatch.rect(px, py, px + POWERUP_W, py + POWERUP_H, {0.95f, 0.75f, 0.15f, 1.0f});
+        frameBatch.rect(px + 3, py + POWERUP_H - 5, px + POWERUP_W - 3, py + POWERUP_H - 2, {1.0f, 1.0f, 1.0f, 0.4f});
+    }
+    batchRenderer.drawDynamic(frameBatch, renderStats);
+
+    // Draw player name above paddle
+   // drawText(padX + padW/2 - 30, padY + padH + 10, playerName, GLUT_BITMAP_9_BY_15, {0.95f,0.95f,0.95f,1});
+
+    // Draw score and lives (new small HUD box)
+    glBegin(GL_QUADS);
+    glColor4f(0.05f,0.05f,0.06f,0.65f);
+    glVertex2f(10, WIN_H-40); glVertex2f(320, WIN_H-40);
+    glVertex2f(320, WIN_H-10); glVertex2f(10, WIN_H-10);
+    glEnd();
+    countImmediate(4);
+
+    PROFILE_SCOPE("draw.text");
+    const FontMetrics& big = textRenderer.metrics(GLUT_BITMAP_HELVETICA_18);
+    const FontMetrics& small = textRenderer.metrics(GLUT_BITMAP_9_BY_15);
+    const Color hud = {0.9f,0.9f,0.95f,1};
+    hudScore.setNumber(big, 20, WIN_H-28, "Score: ", world.score, hud);
+    hudLives.setNumber(small, 20, WIN_H-48, "Lives: ", world.lives, hud);
+    // additional info
+    hudPlayer.set(small, 140, WIN_H-48, "Player: ", playerName.c_str(), hud);
+    hudSpeed.setNumber(small, 140, WIN_H-28, "Speed: ", (int)world.padSpeed, hud);
+    drawLabel(hudScore, GLUT_BITMAP_HELVETICA_18);
+    drawLabel(hudLives, GLUT_BITMAP_9_BY_15);
+    drawLabel(hudPlayer, GLUT_BITMAP_9_BY_15);
+    drawLabel(hudSpeed, GLUT_BITMAP_9_BY_15);
+
+    // Sound status in HUD
+    hudSound.set(small, 240, WIN_H-28, soundEnabled ? "Sound: ON" : "Sound: OFF", {0.95f,0.9f,0.6f,1});
+    drawLabel(hudSound, GLUT_BITMAP_9_BY_15);
+
+    // Draw controls help
+    static const char* help[4] = {"Arrow Keys/Mouse: Move", "SPACE: Release Ball", "P: Pause", "ESC: Menu | M: Toggle Sound"};
+    for(int i=0; i<4; i++) {
+        hudHelp[i].set(small, WIN_W-300, WIN_H-30-i*20, help[i], {0.9f,0.9f,0.95f,0.9f});
+        drawLabel(hudHelp[i], GLUT_BITMAP_9_BY_15);
+    }
+
+    if(versusMode) drawRivalBoard();
+
+    // Renderer stats for the previous frame (I to toggle)
+    if(showRenderStats) {
+        char stats[128];
+        std::snprintf(stats, sizeof(stats), "Draw calls: %u  Vertices: %u  Particles: %u  (%s, %s)",
+                      lastFrameStats.drawCalls, lastFrameStats.vertices, particles.live(),
+                      batchRenderer.usingVbo() ? "VBO" : "vertex arrays",
+                      textRenderer.ready() ? "glyph atlas" : "bitmap text");
+        hudStats.set(small, 20, 20, stats, {0.7f,0.95f,0.7f,0.9f});
+        drawLabel(hudStats, GLUT_BITMAP_9_BY_15);
+    }
+}
+
+void drawGameOver() {
+    // Semi-transparent overlay
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    drawText(WIN_W/2-60, WIN_H/2+20, "GAME OVER", GLUT_BITMAP_HELVETICA_18, {1,0.3f,0.3f,1});
+    drawText(WIN_W/2-80, WIN_H/2-10, frameArena.format("Score: %d", world.score), GLUT_BITMAP_HELVETICA_18, {1,1,1,1});
+    drawText(WIN_W/2-100, WIN_H/2-40, "Press ENTER for next player", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+    drawText(WIN_W/2-80, WIN_H/2-60, "ESC for Menu", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+}
+
+void drawWinScreen() {
+    // Semi-transparent overlay
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+    glVertex2f(0, 0); glVertex2f(WIN_W, 0);
+    glVertex2f(WIN_W, WIN_H); glVertex2f(0, WIN_H);
+    glEnd();
+    countImmediate(4);
+
+    drawText(WIN_W/2-40, WIN_H/2+20, "YOU WIN!", GLUT_BITMAP_HELVETICA_18, {0.4f,1.0f,0.6f,1});
+    drawText(WIN_W/2-80, WIN_H/2-10, frameArena.format("Score: %d", world.score), GLUT_BITMAP_HELVETICA_18, {1,1,1,1});
+    drawText(WIN_W/2-120, WIN_H/2-40, "Press ENTER for next player", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+    drawText(WIN_W/2-100, WIN_H/2-60, "ESC for Menu", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+}
+
+// Multi-board round over: the best board and how to go on
+void drawBoardsResult() {
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+    glVertex2f(WIN_W/2-200, WIN_H/2-80); glVertex2f(WIN_W/2+200, WIN_H/2-80);
+    glVertex2f(WIN_W/2+200, WIN_H/2+50); glVertex2f(WIN_W/2-200, WIN_H/2+50);
+    glEnd();
+    countImmediate(4);
+
+    uint32_t best = 0;
+    for(uint32_t i=1; i<boardSet.size(); i++) {
+        if(boardSet[i].world.score > boardSet[best].world.score) best = i;
+    }
+    const char* title = gState == GameState::WIN ? "BOARD CLEARED!" : "ROUND OVER";
+    drawText(WIN_W/2-70, WIN_H/2+20, title, GLUT_BITMAP_HELVETICA_18, {0.4f,1.0f,0.6f,1});
+    drawText(WIN_W/2-150, WIN_H/2-10, frameArena.format("Top: %s with %d", boardName(best), boardSet[best].world.score),
+             GLUT_BITMAP_HELVETICA_18, {1,1,1,1});
+    drawText(WIN_W/2-110, WIN_H/2-40, "Press ENTER for a new round", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+    drawText(WIN_W/2-55, WIN_H/2-60, "ESC for Menu", GLUT_BITMAP_9_BY_15, {0.8f,0.8f,1,1});
+}
+
+// Frame-time and input-latency percentiles (latency turns red once its p99
+// exceeds a typical frame), per-frame counters and one bar per profiled phase
+// (inclusive time over all threads; the bar is full at 16.7 ms)
+void drawProfilerOverlay() {
+    const std::vector<FrameProfiler::Phase>& phases = frameProfiler.phases();
+    float top = WIN_H - 70, rowH = 16, left = WIN_W - 330;
+    float firstRow = top - 58;
+    float bottom = firstRow - rowH * phases.size();
+    overlayBatch.clear();
+    overlayBatch.rect(left - 10, bottom - 6, WIN_W - 10, top + 18, {0.0f, 0.0f, 0.0f, 0.7f});
+    for(size_t i=0; i<phases.size(); i++) {
+        float y = firstRow - rowH * i;
+        float w = float(std::min(1.0, phases[i].avgMs / 16.7)) * 150.0f;
+        overlayBatch.rect(left + 160, y, left + 160 + std::max(w, 1.0f), y + rowH - 4, {0.3f, 0.8f, 0.5f, 0.9f});
+    }
+    batchRenderer.drawDynamic(overlayBatch, renderStats);
+
+    const FrameCounters& c = frameProfiler.lastCounters();
+    char line[96];
+    std::snprintf(line, sizeof(line), "Frame ms p50 %.2f p95 %.2f p99 %.2f max %.2f",
+                  frameProfiler.frameMs(50), frameProfiler.frameMs(95), frameProfiler.frameMs(99), frameProfiler.frameMs(100));
+    drawText(left, top, line, GLUT_BITMAP_9_BY_15, {0.9f,0.95f,0.7f,1});
+    std::snprintf(line, sizeof(line), "Input->present p50 %.2f p99 %.2f ms", frameProfiler.inputLatencyMs(50),
+                  frameProfiler.inputLatencyMs(99));
+    bool late = frameProfiler.inputLatencyMs(99) > frameProfiler.frameMs(50) && frameProfiler.inputLatencySamples() > 0;
+    drawText(left, top - 18, line, GLUT_BITMAP_9_BY_15, late ? Color{1,0.5f,0.4f,1} : Color{0.9f,0.95f,0.7f,1});
+    std::snprintf(line, sizeof(line), "Draws %u  Sounds %u  Allocs %llu%s", c.drawCalls, c.sounds,
+                  (unsigned long long)c.allocs, frameProfiler.tracing() ? "  TRACE" : "");
+    drawText(left, top - 36, line, GLUT_BITMAP_9_BY_15, {0.9f,0.95f,0.7f,1});
+    for(size_t i=0; i<phases.size(); i++) {
+        std::snprintf(line, sizeof(line), "%-13.13s %5.2f", phases[i].name, phases[i].avgMs);
+        drawText(left, firstRow - rowH * i, line, GLUT_BITMAP_9_BY_15, {0.85f,0.85f,0.9f,1});
+    }
+}
+
+void toggleTrace() {
+    if(!frameProfiler.tracing()) {
+        frameProfiler.setEnabled(true);
+        frameProfiler.startTrace();
+        return;
+    }
+    std::string error;
+    if(frameProfiler.stopTrace(tracePath, error)) std::cout << "Trace written to " << tracePath << "\n";
+    else std::cout << "Trace: " << error << "\n";
+    frameProfiler.setEnabled(showProfiler);
+}
+
+// Anything that legitimately allocates (a new screen, a new round, a
+// running trace) restarts the steady-state warmup
+void checkFrameAllocs() {
+    static GameState lastState = gState;
+    static MenuScreen lastScreen = currentScreen;
+    bool unsettled = frameUnsettled || gState != lastState || currentScreen != lastScreen || frameProfiler.tracing();
+    lastState = gState;
+    lastScreen = currentScreen;
+    frameUnsettled = false;
+    allocWatch.endFrame(unsettled, gState == GameState::MENU ? "menu" : "game");
+}
+
+void renderScene() {
+    PROFILE_SCOPE("render");
+    frameArena.reset();
+    renderStats.reset();
+    textRenderer.buildAtlas();   // first frame only
+    glClear(GL_COLOR_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    if(gState == GameState::MENU) {
+        switch(currentScreen) {
+            case MenuScreen::MAIN:
+                drawMainMenu();
+                break;
+            case MenuScreen::PLAYER_NAME:
+                drawPlayerNameScreen();
+                break;
+            case MenuScreen::SCORE_BOARD:
+                drawScoreBoard();
+                break;
+        }
+    } else if(gState == GameState::PLAYING) {
+        drawGameScreen();
+    } else if(multiBoard) {
+        drawGameScreen();
+        drawBoardsResult();
+    } else if(gState == GameState::GAME_OVER) {
+        drawGameScreen();
+        drawGameOver();
+    } else if(gState == GameState::WIN) {
+        drawGameScreen();
+        drawWinScreen();
+    }
+    if(showProfiler) drawProfilerOverlay();
+
+    lastFrameStats = renderStats;
+    {
+        PROFILE_SCOPE("swap");
+        glutSwapBuffers();
+    }
+    FrameCounters counters;
+    double inputTime = input.takeConsumedEventTime();
+    if(inputTime >= 0.0) counters.inputLatencyMs = (monotonicSeconds() - inputTime) * 1e3;
+    counters.drawCalls = lastFrameStats.drawCalls;
+    counters.sounds = soundsThisFrame;
+    soundsThisFrame = 0;
+    frameProfiler.endFrame(counters);
+    if(allocCheck) checkFrameAllocs();
+}
+
+// Chips flying off a brick, in the brick's colour
+void emitBrickDebris(uint32_t brick, uint32_t count) {
+    const BrickStore& b = world.bricks;
+    if(brick >= b.count) return;
+    particles.burst(b.x[brick] + b.w[brick] * 0.5f, b.y[brick] + b.h[brick] * 0.5f, count,
+                    b.palette[b.paletteIndex[brick]], 300.0f, 0.9f);
+}
+
+// Turn simulation events into sounds and state changes
+void handleWorldEvents() {
+    for(const SimEvent& e : world.events) {
+        switch(e.type) {
+            case SimEventType::PADDLE_HIT:
+                particles.burst(e.x, e.y, 12, {1.0f, 0.95f, 0.7f, 1.0f}, 420.0f, 0.35f);
+                playSfx(SoundId::PADDLE);
+                break;
+            case SimEventType::POWERUP:
+                playSfx(SoundId::PADDLE);
+                break;
+            case SimEventType::BRICK_HIT:
+                brickMesh.killBrick(e.brick);
+                emitBrickDebris(e.brick, 40);
+                playSfx(SoundId::HIT);
+                break;
+            case SimEventType::BRICK_DAMAGED:
+                emitBrickDebris(e.brick, 8);
+                playSfx(SoundId::HIT);
+                break;
+            case SimEventType::LOSE_LIFE:
+                playSfx(SoundId::LOSE);
+                break;
+            case SimEventType::SCROLL:
+                // the level moved up a screen: new bricks, new indices
+                brickMesh.build(world.bricks);
+                playSfx(SoundId::MENU);
+                break;
+            case SimEventType::GAME_OVER:
+                // Round ended by losing all lives -> record run once, update best, and go to GAME_OVER
+                saveBestForCurrentPlayer();
+                saveReplayIfRecording();
+                recordScoreboardEntryIfNeeded();
+                preloadLevel(levelNames[levelIndex]);
+                gState = GameState::GAME_OVER;
+                break;
+            case SimEventType::WIN:
+                // Round ended by clearing all blocks -> record run once, update best, and go to WIN
+                saveBestForCurrentPlayer();
+                saveReplayIfRecording();
+                recordScoreboardEntryIfNeeded();
+                levelIndex = (levelIndex + 1) % levelNames.size();
+                preloadLevel(levelNames[levelIndex]);
+                gState = GameState::WIN;
+                playSfx(SoundId::WIN);
+                break;
+        }
+    }
+}
+
+// Versus ticks: a step happens only when the session may advance (it waits
+// for a rival that is too far behind); both boards keep running after the
+// local round ends so the rival still gets our inputs
+void updateVersus(double now, int steps) {
+    versusPeer.poll(now);
+    RollbackSession& session = versusPeer.session();
+    int advanced = 0;
+    for(int i=0; i<steps; i++) {
+        if(!session.canAdvance()) {
+            versusStalls++;
+            break;
+        }
+        session.addLocalInput(input.sample(float(simClock.dt), world.padSpeed * KEY_REPEAT_HZ));
+        {
+            PROFILE_SCOPE("sim.rollback");
+            session.advance();
+        }
+        recorder.tick(session.localInput(session.frame() - 1), world);
+        PROFILE_SCOPE("sim.events");
+        handleWorldEvents();
+        advanced++;
+    }
+    if(advanced || now - versusLastSend >= simClock.dt) {
+        versusPeer.send(now);
+        versusLastSend = now;
+    }
+}
+
+// One board's events at its tile: effects for every board, sounds and
+// scores only for the boards people are playing
+void handleBoardEvents(uint32_t i) {
+    const Board& b = boardSet[i];
+    const BrickStore& bricks = b.world.bricks;
+    BoardTile t = boardTile(i);
+    bool player = i < boardPlayers;
+    for(const SimEvent& e : b.events) {
+        switch(e.type) {
+            case SimEventType::PADDLE_HIT:
+                particles.burst(t.left + e.x * t.scale, t.bottom + e.y * t.scale, 6, {1.0f, 0.95f, 0.7f, 1.0f},
+                                420.0f * t.scale, 0.35f);
+                if(player) playSfx(SoundId::PADDLE);
+                break;
+            case SimEventType::BRICK_HIT:
+            case SimEventType::BRICK_DAMAGED:
+                if(e.brick < bricks.count) {
+                    particles.burst(t.left + (bricks.x[e.brick] + bricks.w[e.brick] * 0.5f) * t.scale,
+                                    t.bottom + (bricks.y[e.brick] + bricks.h[e.brick] * 0.5f) * t.scale,
+                                    e.type == SimEventType::BRICK_HIT ? 16 : 4,
+                                    bricks.palette[bricks.paletteIndex[e.brick]], 300.0f * t.scale, 0.9f);
+                }
+                if(player) playSfx(SoundId::HIT);
+                break;
+            case SimEventType::POWERUP:
+                if(player) playSfx(SoundId::PADDLE);
+                break;
+            case SimEventType::LOSE_LIFE:
+                if(player) playSfx(SoundId::LOSE);
+                break;
+            case SimEventType::SCROLL:
+                if(player) playSfx(SoundId::MENU);
+                break;
+            case SimEventType::GAME_OVER:
+            case SimEventType::WIN:
+                if(player) {
+                    saveBest(int(i), playerNames[i], b.world.score);
+                    recordRun(int(i), playerNames[i], b.world.score);
+                }
+                break;
+        }
+    }
+}
+
+// Multi-board ticks: queue the players' inputs, run every board to the
+// barrier, then take their events. The round ends when every board is out
+// or cleared; a board a player cleared moves everyone to the next level.
+void updateBoards(int steps) {
+    if(gState != GameState::PLAYING || steps == 0) return;
+    float dt = float(simClock.dt);
+    for(uint32_t i=0; i<boardPlayers; i++) {
+        Board& b = boardSet[i];
+        InputState& in = i == 0 ? input : boardInput[i - 1];
+        b.inputs.clear();
+        for(int s=0; s<steps; s++) b.inputs.push_back(in.sample(dt, b.world.padSpeed * KEY_REPEAT_HZ));
+    }
+    {
+        PROFILE_SCOPE("sim.boards");
+        boardSet.advance(steps, dt);
+    }
+    PROFILE_SCOPE("sim.events");
+    for(uint32_t i=0; i<boardSet.size(); i++) handleBoardEvents(i);
+    if(!boardSet.allOver()) return;
+    bool cleared = false;
+    for(uint32_t i=0; i<boardPlayers; i++) cleared = cleared || boardSet[i].world.round == RoundState::CLEARED;
+    if(cleared) {
+        levelIndex = (levelIndex + 1) % levelNames.size();
+        gState = GameState::WIN;
+        playSfx(SoundId::WIN);
+    } else {
+        gState = GameState::GAME_OVER;
+        playSfx(SoundId::LOSE);
+    }
+    preloadLevel(levelNames[levelIndex]);
+}
+
+// Playing, a versus round still running, or debris still settling
+bool needsContinuousFrames() {
+    if(gState == GameState::PLAYING) return true;
+    if(gState == GameState::MENU) return false;
+    return versusMode || particles.live() > 0;
+}
+
+bool menuAnimating() {
+    return gState == GameState::MENU && currentScreen == MenuScreen::MAIN && menuPulseHz > 0.0;
+}
+
+void update();
+
+void pulseTimer(int) {
+    pulseTimerArmed = false;
+    if(continuousFrames || !menuAnimating()) return;
+    glutPostRedisplay();
+    pulseTimerArmed = true;
+    glutTimerFunc(unsigned(1000.0 / menuPulseHz), pulseTimer, 0);
+}
+
+// Switch between the idle loop and on-demand frames after a state change
+void scheduleFrames() {
+    bool continuous = needsContinuousFrames();
+    if(continuous != continuousFrames) {
+        continuousFrames = continuous;
+        if(continuous) simClock.reset(monotonicSeconds());
+        glutIdleFunc(continuous ? update : nullptr);
+    }
+    if(!continuous && menuAnimating() && !pulseTimerArmed) {
+        pulseTimerArmed = true;
+        glutTimerFunc(unsigned(1000.0 / menuPulseHz), pulseTimer, 0);
+    }
+}
+
+// Idle callback: run however many fixed steps the elapsed time calls for, then redraw
+void update() {
+    double now = monotonicSeconds();
+    double prev = simClock.lastTime < 0.0 ? now : simClock.lastTime;
+    int steps = simClock.advance(now);
+
+    PROFILE_SCOPE("update");
+    if(gState != GameState::MENU) {
+        PROFILE_SCOPE("particles");
+        particles.update(float(std::min(now - prev, 0.1)));
+    }
+    if(versusMode && gState != GameState::MENU) {
+        updateVersus(now, steps);
+        glutPostRedisplay();
+        scheduleFrames();
+        return;
+    }
+    if(multiBoard && gState != GameState::MENU) {
+        updateBoards(steps);
+        glutPostRedisplay();
+        scheduleFrames();
+        return;
+    }
+    for(int i=0; i<steps && gState == GameState::PLAYING; i++) {
+        GameInput in = input.sample(float(simClock.dt), world.padSpeed * KEY_REPEAT_HZ);
+        {
+            PROFILE_SCOPE("sim.step");
+            world.step(in, float(simClock.dt));
+        }
+        recorder.tick(in, world);
+        PROFILE_SCOPE("sim.events");
+        handleWorldEvents();
+    }
+    glutPostRedisplay();
+    scheduleFrames();
+}
+
+void handleMenuAction() {
+    switch(menuSelection) {
+        case 0: // START GAME
+            gState = GameState::PLAYING;
+            resetLevel();
+            playSfx(SoundId::MENU);
+            break;
+        case 1: // PLAYER NAME
+            currentScreen = MenuScreen::PLAYER_NAME;
+            tempName = playerName;
+            playSfx(SoundId::MENU);
+            break;
+        case 2: // SCORE BOARD
+            saveBestForCurrentPlayer();
+            currentScreen = MenuScreen::SCORE_BOARD;
+            playSfx(SoundId::MENU);
+            break;
+        case 3: // EXIT
+            if(frameProfiler.tracing()) toggleTrace();
+            scoreLog.close();
+            exit(0);
+            break;
+    }
+}
+
+void handleKey(unsigned char key) {
+    if(gState == GameState::MENU) {
+
+        // Name entry screen input
+        if(currentScreen == MenuScreen::PLAYER_NAME) {
+            if(key == 13) { // ENTER
+                if(!tempName.empty()) {
+                    playerName = tempName;
+                    playerNames[currentPlayer] = tempName;
+                }
+                currentScreen = MenuScreen::MAIN;
+                playSfx(SoundId::MENU);
+            } else if(key == 27) { // ESC
+                currentScreen = MenuScreen::MAIN;
+                playSfx(SoundId::MENU);
+            } else if(key == 8) { // BACKSPACE
+                if(!tempName.empty()) tempName.pop_back();
+            } else if(key >= 32 && key <= 126) { // Printable characters
+                if(tempName.length() < 15) tempName += key;
+            }
+            return;
+        }
+
+        // Generic ESC = Back for submenus (e.g., SCORE_BOARD)
+        if(key == 27) {
+            if(currentScreen != MenuScreen::MAIN) {
+                currentScreen = MenuScreen::MAIN;
+                playSfx(SoundId::MENU);
+                return;
+            }
+        }
+
+        // Main menu navigation
+        if(key >= '1' && key <= '4') {
+            menuSelection = key - '1';
+            playSfx(SoundId::MENU);
+        } else if(key == 13) { // ENTER
+            handleMenuAction();
+        } else if(key == 'm' || key == 'M') { // toggle sound
+            soundEnabled = !soundEnabled;
+            // Play a tiny menu sound only if enabling sound (to confirm). If disabling, obviously don't play.
+            if(soundEnabled) playSfx(SoundId::MENU);
+        }
+    } else if(gState == GameState::PLAYING) {
+        if(key == 27) { // ESC to menu
+            saveBestForCurrentPlayer();
+            saveReplayIfRecording();
+            versusPeer.close();
+            gState = GameState::MENU;
+            playSfx(SoundId::MENU);
+        } else if(key == ' ') { // SPACE to release ball
+            input.launch(monotonicSeconds());
+        } else if(key == 'p' || key == 'P') {
+            // Pause can be added here
+        } else if(key == 'i' || key == 'I') { // renderer stats overlay
+            showRenderStats = !showRenderStats;
+        } else if(key == 'f' || key == 'F') { // profiler overlay
+            showProfiler = !showProfiler;
+            frameProfiler.setEnabled(showProfiler || frameProfiler.tracing());
+        } else if(key == 't' || key == 'T') { // chrome://tracing capture
+            toggleTrace();
+        } else if(key == 'm' || key == 'M') { // sound toggle while playing
+            soundEnabled = !soundEnabled;
+            if(soundEnabled) playSfx(SoundId::MENU);
+        }
+    } else if(gState == GameState::GAME_OVER || gState == GameState::WIN) {
+        if(key == 13 && multiBoard) { // the boards' players were scored as their boards ended: just a new round
+            resetLevel();
+            gState = GameState::PLAYING;
+        } else if(key == 13) { // ENTER
+            // Ensure best saved and scoreboard entry recorded (should already be), then progress to next player + new round
+            saveBestForCurrentPlayer();
+            recordScoreboardEntryIfNeeded();
+            if(versusMode) { // a match is one round; start the next one from the menu together
+                versusPeer.close();
+                gState = GameState::MENU;
+                playSfx(SoundId::MENU);
+                return;
+            }
+            nextPlayer();
+            gState = GameState::PLAYING;
+        } else if(key == 27) { // ESC to menu
+            if(!multiBoard) {
+                saveBestForCurrentPlayer();
+                recordScoreboardEntryIfNeeded();
+            }
+            versusPeer.close();
+            gState = GameState::MENU;
+            playSfx(SoundId::MENU);
+        } else if(key == 'm' || key == 'M') {
+            soundEnabled = !soundEnabled;
+            if(soundEnabled) playSfx(SoundId::MENU);
+        }
+    }
+}
+
+// Multi-board: A/D/W steer and launch the second board, J/L/K the third
+bool boardPlayerKey(unsigned char key, bool down) {
+    static const char KEYS[2][3] = {{'a', 'd', 'w'}, {'j', 'l', 'k'}};
+    if(!multiBoard) return false;
+    if(key >= 'A' && key <= 'Z') key = key - 'A' + 'a';
+    for(uint32_t p=0; p+1<boardPlayers && p<2; p++) {
+        InputState& in = boardInput[p];
+        double now = monotonicSeconds();
+        if(key == KEYS[p][0]) down ? in.keyDown(InputKey::LEFT, now) : in.keyUp(InputKey::LEFT, now);
+        else if(key == KEYS[p][1]) down ? in.keyDown(InputKey::RIGHT, now) : in.keyUp(InputKey::RIGHT, now);
+        else if(key == KEYS[p][2]) { if(down) in.launch(now); }
+        else continue;
+        return true;
+    }
+    return false;
+}
+
+// Every key can change what is on screen
+void keyboard(unsigned char key, int, int) {
+    frameUnsettled = true;
+    if(gState == GameState::PLAYING && boardPlayerKey(key, true)) return;
+    handleKey(key);
+    scheduleFrames();
+    glutPostRedisplay();
+}
+
+void keyboardUp(unsigned char key, int, int) {
+    boardPlayerKey(key, false);
+}
+
+// Arrow keys only change key state; the paddle moves in the simulation step
+void specialKeys(int key, int, int) {
+    if(gState != GameState::PLAYING) return;
+    if(key == GLUT_KEY_LEFT) input.keyDown(InputKey::LEFT, monotonicSeconds());
+    else if(key == GLUT_KEY_RIGHT) input.keyDown(InputKey::RIGHT, monotonicSeconds());
+}
+
+// Key-ups are tracked in every state so a key released in a menu isn't stuck
+void specialKeysUp(int key, int, int) {
+    if(key == GLUT_KEY_LEFT) input.keyUp(InputKey::LEFT, monotonicSeconds());
+    else if(key == GLUT_KEY_RIGHT) input.keyUp(InputKey::RIGHT, monotonicSeconds());
+}
+
+void mouseMotion(int x, int y) {
+    if(gState != GameState::PLAYING) return;
+    if(multiBoard && boardPlayers > 0) { // the mouse steers the first board, inside its tile
+        BoardTile t = boardTile(0);
+        input.mouseMove((float(x) - t.left) / t.scale, monotonicSeconds());
+        return;
+    }
+    input.mouseMove(float(x), monotonicSeconds());
+}
+
+void mouseClick(int button, int state, int, int) {
+    if(gState == GameState::PLAYING && button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
+        input.launch(monotonicSeconds());
+    }
+}
+
+void reshape(int w, int h) {
+    glViewport(0, 0, w, h);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluOrtho2D(0, WIN_W, 0, WIN_H);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+}
+
+int main(int argc, char** argv) {
+    sessionRng.seed((uint64_t)std::time(nullptr));
+
+    glutInit(&argc, argv);
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA);
+    glutInitWindowSize(WIN_W, WIN_H);
+    glutCreateWindow("DX Ball");
+    batchRenderer.init();
+
+    glutDisplayFunc(renderScene);
+    glutKeyboardFunc(keyboard);
+    glutKeyboardUpFunc(keyboardUp);
+    glutSpecialFunc(specialKeys);
+    glutSpecialUpFunc(specialKeysUp);
+    glutPassiveMotionFunc(mouseMotion);
+    glutMouseFunc(mouseClick);
+    glutReshapeFunc(reshape);
+
+    // Optional: --sim-hz N (simulation rate), --substeps N (max steps per displayed frame),
+    // --audio null|wav:<file> (sound output), --pack <file> (asset pack),
+    // --record <file> (replay of the last round, "" to disable), --scores <file> (score log),
+    // --levels a,b,... (level files, looked up in the pack first, or RxC walls),
+    // --trace <file> (profile from startup; T stops and writes the trace),
+    // --particles N (live particle budget, 0 turns effects off),
+    // --physics float|fixed (fixed = Q16.16 integer physics, bit-identical on every build),
+    // --menu-fps N (menu highlight redraw rate, 0 = redraw on input only),
+    // --alloc-check warn|abort (report heap allocations in steady-state frames),
+    // --boards N (N boards at once, tiled) with --board-players P (0-3 keyboard players,
+    // the rest run the autopilot) and --board-threads T (workers, default one per core),
+    // --versus <player 0|1> <local port> <rival host:port> (rollback versus over UDP) with
+    // --versus-seed S, --input-delay F, --net-delay ms, --net-jitter ms, --net-loss pct
+    // (artificial link conditions, for trying it on localhost)
+    simClock.setRate(DEFAULT_SIM_HZ);
+    std::string audioOut;
+    std::string packPath = "dxball.pak";
+    for(int i=1; i+1<argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--sim-hz") simClock.setRate(std::max(10.0, std::atof(argv[++i])));
+        else if(arg == "--substeps") simClock.maxSubsteps = std::max(1, std::atoi(argv[++i]));
+        else if(arg == "--audio") audioOut = argv[++i];
+        else if(arg == "--pack") packPath = argv[++i];
+        else if(arg == "--record") replayPath = argv[++i];
+        else if(arg == "--scores") scoreLogPath = argv[++i];
+        else if(arg == "--trace") { tracePath = argv[++i]; toggleTrace(); }
+        else if(arg == "--alloc-check") {
+            allocCheck = true;
+            allocWatch.fatal = std::string(argv[++i]) == "abort";
+        }
+        else if(arg == "--physics") physicsMode = std::string(argv[++i]) == "fixed" ? PhysicsMode::FIXED : PhysicsMode::FLOAT;
+        else if(arg == "--menu-fps") menuPulseHz = std::max(0.0, std::atof(argv[++i]));
+        else if(arg == "--particles") particles.budget = uint32_t(std::max(0, std::atoi(argv[++i])));
+        else if(arg == "--versus" && i + 3 < argc) {
+            versusCfg.localPlayer = std::atoi(argv[++i]) == 1 ? 1 : 0;
+            versusCfg.localPort = uint16_t(std::atoi(argv[++i]));
+            versusMode = parseNetAddress(argv[++i], versusCfg.remote);
+            if(!versusMode) std::cout << "Versus: bad rival address " << argv[i] << "\n";
+        }
+        else if(arg == "--boards") boardCount = uint32_t(std::max(1, std::min(64, std::atoi(argv[++i]))));
+        else if(arg == "--board-players") boardPlayers = uint32_t(std::max(0, std::min(3, std::atoi(argv[++i]))));
+        else if(arg == "--board-threads") boardThreads = unsigned(std::max(0, std::atoi(argv[++i])));
+        else if(arg == "--versus-seed") versusSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if(arg == "--input-delay") versusCfg.inputDelay = uint32_t(std::max(0, std::atoi(argv[++i])));
+        else if(arg == "--net-delay") versusCfg.link.delayMs = float(std::atof(argv[++i]));
+        else if(arg == "--net-jitter") versusCfg.link.jitterMs = float(std::atof(argv[++i]));
+        else if(arg == "--net-loss") versusCfg.link.lossPercent = float(std::atof(argv[++i]));
+        else if(arg == "--levels") {
+            levelNames.clear();
+            std::string list = argv[++i];
+            for(size_t at=0; at<=list.size();) {
+                size_t comma = std::min(list.find(',', at), list.size());
+                if(comma > at) levelNames.push_back(list.substr(at, comma - at));
+                at = comma + 1;
+            }
+            if(levelNames.empty()) levelNames.push_back("4x8");
+        }
+    }
+
+    multiBoard = boardCount > 1 && !versusMode;
+    boardPlayers = std::min(boardPlayers, boardCount);
+
+    if(!scoreLog.open(scoreLogPath, loadScoreRecord)) std::cout << "Score log " << scoreLogPath << " could not be opened; scores won't be kept.\n";
+    else if(scoreLog.droppedBytes()) std::cout << "Score log: dropped " << scoreLog.droppedBytes() << " bytes of a torn record\n";
+
+    profileThreadName("main");
+
+    // Levels may come from the pack, so map it before the first round
+    bool packed = assets.open(packPath.c_str());
+
+    // Initialize game
+    playerName = playerNames[currentPlayer];
+    resetLevel();
+
+    // Print to console about sound files presence (helpful for debugging)
+    std::cout << "Renderer: " << (batchRenderer.usingVbo() ? "vertex buffer objects" : "client vertex arrays") << "\n";
+    // Decode every sound once, then start the mixer on the chosen output
+    std::cout << "Sound enabled: " << (soundEnabled ? "YES" : "NO") << "\n";
+    std::cout << "Asset pack " << packPath << ": " << (packed ? "mapped" : "not found, using loose files") << "\n";
+    for(const auto& s : SOUND_FILES) {
+        AssetView view;
+        bool loaded = packed ? (assets.get(s.file, view) && audio.loadSound(s.id, view.data, view.size, true))
+                             : audio.loadSound(s.id, s.file);
+        std::cout << s.file << " present: " << (loaded ? "YES" : "NO") << "\n";
+    }
+    if(!packed) std::cout << "If you want cartoon sounds, place the above .wav files next to the executable.\n";
+#ifdef _WIN32
+    audio.setFallback(playAliasFallback);
+#endif
+    std::unique_ptr<AudioSink> sink;
+    if(audioOut == "null") {
+        sink.reset(new NullAudioSink());
+    } else if(audioOut.compare(0, 4, "wav:") == 0) {
+        sink.reset(new WavFileAudioSink(audioOut.substr(4)));
+    } else {
+#ifdef _WIN32
+        sink = makeWinMMAudioSink();
+#else
+        sink.reset(new NullAudioSink());
+#endif
+    }
+    if(!audio.start(std::move(sink))) std::cout << "Audio output could not be opened; running silent.\n";
+
+    scheduleFrames();
+    glutMainLoop();
+    return 0;
+}
@@ -0,0 +1,110 @@
+// net_udp.cpp - minimal non-blocking IPv4 UDP sockets (POSIX and Winsock)
+#include "net_udp.h"
+#include <cstdio>
+#include <cstdlib>
+#ifdef _WIN32
+#include <winsock2.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+bool parseNetAddress(const std::string& s, NetAddress& out) {
+    size_t colon = s.rfind(':');
+    if(colon == std::string::npos) return false;
+    std::string host = s.substr(0, colon);
+    int port = std::atoi(s.c_str() + colon + 1);
+    if(port <= 0 || port > 65535) return false;
+    if(host == "localhost") host = "127.0.0.1";
+    unsigned a, b, c, d;
+    char tail;
+    if(std::sscanf(host.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+        return false;
+    out.ip = (a << 24) | (b << 16) | (c << 8) | d;
+    out.port = uint16_t(port);
+    return true;
+}
+
+bool UdpSocket::open(uint16_t wantPort) {
+    close();
+#ifdef _WIN32
+    static bool started = false;
+    if(!started) {
+        WSADATA wsa;
+        if(WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+        started = true;
+    }
+    SOCKET s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if(s == INVALID_SOCKET) return false;
+    u_long nonBlocking = 1;
+    ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+    int s = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if(s < 0) return false;
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(wantPort);
+    socklen_t len = sizeof(addr);
+    if(::bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+       ::getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+#ifdef _WIN32
+        closesocket(s);
+#else
+        ::close(s);
+#endif
+        return false;
+    }
+    sock = intptr_t(s);
+    port = ntohs(addr.sin_port);
+    return true;
+}
+
+void UdpSocket::close() {
+    if(sock == -1) return;
+#ifdef _WIN32
+    closesocket(SOCKET(sock));
+#else
+    ::close(int(sock));
+#endif
+    sock = -1;
+    port = 0;
+}
+
+bool UdpSocket::sendTo(const NetAddress& to, const void* data, size_t size) {
+    if(sock == -1) return false;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(to.ip);
+    addr.sin_port = htons(to.port);
+#ifdef _WIN32
+    int n = ::sendto(SOCKET(sock), static_cast<const char*>(data), int(size), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+#else
+    ssize_t n = ::sendto(int(sock), data, size, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+#endif
+    return n == int(size);
+}
+
+int UdpSocket::receive(void* buf, size_t capacity, NetAddress* from) {
+    if(sock == -1) return -1;
+    sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+#ifdef _WIN32
+    int n = ::recvfrom(SOCKET(sock), static_cast<char*>(buf), int(capacity), 0, reinterpret_cast<sockaddr*>(&addr), &len);
+#else
+    ssize_t n = ::recvfrom(int(sock), buf, capacity, 0, reinterpret_cast<sockaddr*>(&addr), &len);
+#endif
+    if(n < 0) return -1;
+    if(from) {
+        from->ip = ntohl(addr.sin_addr.s_addr);
+        from->port = ntohs(addr.sin_port);
+    }
+    return int(n);
+}
@@ -0,0 +1,37 @@
+// net_udp.h - minimal non-blocking IPv4 UDP sockets (POSIX and Winsock)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct NetAddress {
+    uint32_t ip = 0;          // host byte order
+    uint16_t port = 0;
+
+    bool operator==(const NetAddress& o) const { return ip == o.ip && port == o.port; }
+};
+
+// "a.b.c.d:port" or "localhost:port"
+bool parseNetAddress(const std::string& s, NetAddress& out);
+
+class UdpSocket {
+public:
+    UdpSocket() {}
+    ~UdpSocket() { close(); }
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Bind to all interfaces on `port` (0 picks a free one), non-blocking
+    bool open(uint16_t port);
+    void close();
+    bool isOpen() const { return sock != -1; }
+    uint16_t localPort() const { return port; }
+
+    bool sendTo(const NetAddress& to, const void* data, size_t size);
+    // Size of the next waiting datagram copied into buf, or -1 if none
+    int receive(void* buf, size_t capacity, NetAddress* from);
+
+private:
+    intptr_t sock = -1;
+    uint16_t port = 0;
+};
@@ -0,0 +1,196 @@
+// particles.cpp - SoA particle pool with vector update kernels
+#include "particles.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DX_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct StepParams {
+    float dt, vyGain, damp;
+};
+
+// All kernels cover [0, n) with n a multiple of ParticlePool::LANES; lanes
+// past the live count are padding and may hold stale values
+typedef void (*UpdateFn)(float* x, float* y, float* vx, float* vy, float* life, uint32_t n, const StepParams& p);
+
+void updateScalar(float* x, float* y, float* vx, float* vy, float* life, uint32_t n, const StepParams& p) {
+    for(uint32_t i=0; i<n; i++) {
+        x[i] += vx[i] * p.dt;
+        y[i] += vy[i] * p.dt;
+        vx[i] *= p.damp;
+        vy[i] = (vy[i] + p.vyGain) * p.damp;
+        life[i] = y[i] < 0.0f ? 0.0f : life[i] - p.dt;
+    }
+}
+
+#ifdef DX_X86_KERNELS
+
+void updateSse2(float* x, float* y, float* vx, float* vy, float* life, uint32_t n, const StepParams& p) {
+    __m128 dt = _mm_set1_ps(p.dt), gain = _mm_set1_ps(p.vyGain), damp = _mm_set1_ps(p.damp);
+    __m128 zero = _mm_setzero_ps();
+    for(uint32_t i=0; i<n; i+=4) {
+        __m128 px = _mm_loadu_ps(&x[i]), py = _mm_loadu_ps(&y[i]);
+        __m128 pvx = _mm_loadu_ps(&vx[i]), pvy = _mm_loadu_ps(&vy[i]);
+        px = _mm_add_ps(px, _mm_mul_ps(pvx, dt));
+        py = _mm_add_ps(py, _mm_mul_ps(pvy, dt));
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(&life[i]), dt);
+        // below the floor: gone
+        l = _mm_and_ps(l, _mm_cmpge_ps(py, zero));
+        _mm_storeu_ps(&x[i], px);
+        _mm_storeu_ps(&y[i], py);
+        _mm_storeu_ps(&vx[i], _mm_mul_ps(pvx, damp));
+        _mm_storeu_ps(&vy[i], _mm_mul_ps(_mm_add_ps(pvy, gain), damp));
+        _mm_storeu_ps(&life[i], l);
+    }
+}
+
+__attribute__((target("avx2")))
+void updateAvx2(float* x, float* y, float* vx, float* vy, float* life, uint32_t n, const StepParams& p) {
+    __m256 dt = _mm256_set1_ps(p.dt), gain = _mm256_set1_ps(p.vyGain), damp = _mm256_set1_ps(p.damp);
+    __m256 zero = _mm256_setzero_ps();
+    for(uint32_t i=0; i<n; i+=8) {
+        __m256 px = _mm256_loadu_ps(&x[i]), py = _mm256_loadu_ps(&y[i]);
+        __m256 pvx = _mm256_loadu_ps(&vx[i]), pvy = _mm256_loadu_ps(&vy[i]);
+        px = _mm256_add_ps(px, _mm256_mul_ps(pvx, dt));
+        py = _mm256_add_ps(py, _mm256_mul_ps(pvy, dt));
+        __m256 l = _mm256_sub_ps(_mm256_loadu_ps(&life[i]), dt);
+        l = _mm256_and_ps(l, _mm256_cmp_ps(py, zero, _CMP_GE_OQ));
+        _mm256_storeu_ps(&x[i], px);
+        _mm256_storeu_ps(&y[i], py);
+        _mm256_storeu_ps(&vx[i], _mm256_mul_ps(pvx, damp));
+        _mm256_storeu_ps(&vy[i], _mm256_mul_ps(_mm256_add_ps(pvy, gain), damp));
+        _mm256_storeu_ps(&life[i], l);
+    }
+}
+
+#endif
+
+ParticleKernel bestKernel() {
+#ifdef DX_X86_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return ParticleKernel::AVX2;
+    if(__builtin_cpu_supports("sse2")) return ParticleKernel::SSE2;
+#endif
+    return ParticleKernel::SCALAR;
+}
+
+ParticleKernel g_kernel = bestKernel();
+
+UpdateFn kernelFn(ParticleKernel k) {
+    switch(k) {
+#ifdef DX_X86_KERNELS
+        case ParticleKernel::AVX2: return updateAvx2;
+        case ParticleKernel::SSE2: return updateSse2;
+#endif
+        default: return updateScalar;
+    }
+}
+
+const float TWO_PI = 6.28318531f;
+
+} // namespace
+
+ParticlePool::ParticlePool(uint32_t capacity) : budget(capacity), cap(capacity) {
+    size_t padded = (size_t(capacity) + LANES - 1) / LANES * LANES;
+    x.assign(padded, 0.0f); y.assign(padded, 0.0f);
+    vx.assign(padded, 0.0f); vy.assign(padded, 0.0f);
+    life.assign(padded, 0.0f); invLife.assign(padded, 0.0f);
+    rgba.assign(padded, 0u);
+    rng.seed(0x5EED);
+}
+
+uint32_t ParticlePool::burst(float px, float py, uint32_t count, const Color& c, float speed, float lifeSec) {
+    uint32_t limit = std::min(budget, cap);
+    uint32_t n = count;
+    if(live_ >= limit) {
+        n = 0;
+    } else {
+        if(live_ > limit / 2) {
+            // scale linearly from the full burst at half budget to nothing at the limit
+            float room = float(limit - live_) / float(limit - limit / 2);
+            n = uint32_t(std::ceil(float(count) * room));
+        }
+        // never past the budget (or the columns), however big the burst
+        n = std::min(n, limit - live_);
+    }
+    dropped_ += count - n;
+    uint8_t col[4] = {
+        uint8_t(std::max(0.0f, std::min(1.0f, c.r)) * 255.0f + 0.5f),
+        uint8_t(std::max(0.0f, std::min(1.0f, c.g)) * 255.0f + 0.5f),
+        uint8_t(std::max(0.0f, std::min(1.0f, c.b)) * 255.0f + 0.5f),
+        uint8_t(std::max(0.0f, std::min(1.0f, c.a)) * 255.0f + 0.5f),
+    };
+    uint32_t packed;
+    std::memcpy(&packed, col, 4);
+    for(uint32_t k=0; k<n; k++) {
+        uint32_t i = live_++;
+        float a = rng.nextFloat() * TWO_PI;
+        float s = speed * (0.3f + 0.7f * rng.nextFloat());
+        float l = lifeSec * (0.6f + 0.4f * rng.nextFloat());
+        x[i] = px; y[i] = py;
+        vx[i] = std::cos(a) * s;
+        vy[i] = std::sin(a) * s;
+        life[i] = l;
+        invLife[i] = 1.0f / l;
+        rgba[i] = packed;
+    }
+    return n;
+}
+
+void ParticlePool::kill(uint32_t i) {
+    uint32_t last = --live_;
+    x[i] = x[last]; y[i] = y[last];
+    vx[i] = vx[last]; vy[i] = vy[last];
+    life[i] = life[last]; invLife[i] = invLife[last];
+    rgba[i] = rgba[last];
+}
+
+void ParticlePool::update(float dt) {
+    if(live_ == 0) return;
+    StepParams p;
+    p.dt = dt;
+    p.vyGain = gravity * dt;
+    p.damp = std::max(0.0f, 1.0f - drag * dt);
+    uint32_t n = (live_ + LANES - 1) / LANES * LANES;
+    kernelFn(g_kernel)(x.data(), y.data(), vx.data(), vy.data(), life.data(), n, p);
+    // swap-remove the expired; the moved-in particle is checked on the same slot
+    for(uint32_t i=0; i<live_; ) {
+        if(life[i] <= 0.0f) kill(i);
+        else i++;
+    }
+}
+
+void ParticlePool::build(std::vector<RenderVertex>& out) const {
+    out.resize(live_);
+    RenderVertex* v = out.data();
+    for(uint32_t i=0; i<live_; i++) {
+        uint8_t col[4];
+        std::memcpy(col, &rgba[i], 4);
+        float fade = std::min(1.0f, life[i] * invLife[i] * 2.0f);
+        v[i].x = x[i];
+        v[i].y = y[i];
+        v[i].r = col[0]; v[i].g = col[1]; v[i].b = col[2];
+        v[i].a = uint8_t(float(col[3]) * fade);
+    }
+}
+
+ParticleKernel activeParticleKernel() { return g_kernel; }
+
+void selectParticleKernel(ParticleKernel k) {
+    ParticleKernel best = bestKernel();
+    g_kernel = (int(k) <= int(best)) ? k : best;
+}
+
+const char* particleKernelName(ParticleKernel k) {
+    switch(k) {
+        case ParticleKernel::AVX2: return "avx2";
+        case ParticleKernel::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,57 @@
+// particles.h - pooled debris and spark effects
+// Purely cosmetic: particles live in the front-end, never in GameWorld, so
+// they are not part of snapshots, replays or the simulation tick. The pool
+// is allocated once (SoA columns padded to whole vector lanes); spawning and
+// dying only move a live count, and the whole pool is drawn as one batch.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "game_world.h"
+#include "render_batch.h"
+
+enum class ParticleKernel { SCALAR, SSE2, AVX2 };
+
+class ParticlePool {
+public:
+    static const uint32_t LANES = 8;
+
+    explicit ParticlePool(uint32_t capacity = 1u << 17);
+
+    // Spawn up to `count` particles at (x,y) flying out at up to `speed` px/s
+    // for about `life` seconds. Past half the budget every burst is thinned
+    // in proportion to the room left, so heavy load trims effects evenly
+    // instead of starving the last emitters. Returns how many were spawned.
+    uint32_t burst(float x, float y, uint32_t count, const Color& c, float speed, float life);
+
+    // Move, fade and expire every live particle
+    void update(float dt);
+
+    // One point vertex per live particle, alpha fading with remaining life.
+    // `out` is resized to live() (grows once, then reuses its storage).
+    void build(std::vector<RenderVertex>& out) const;
+
+    void clear() { live_ = 0; }
+    uint32_t live() const { return live_; }
+    uint32_t capacity() const { return cap; }
+    // Particles refused or thinned away since the last clearStats()
+    uint64_t dropped() const { return dropped_; }
+    void clearStats() { dropped_ = 0; }
+
+    uint32_t budget;                 // live-particle limit, <= capacity
+    float gravity = -900.0f;         // px/s^2 (y points up)
+    float drag = 1.2f;               // velocity lost per second, as a fraction
+
+private:
+    void kill(uint32_t i);
+
+    uint32_t cap, live_ = 0;
+    uint64_t dropped_ = 0;
+    // SoA columns, capacity rounded up to LANES so kernels never need a tail
+    std::vector<float> x, y, vx, vy, life, invLife;
+    std::vector<uint32_t> rgba;      // r,g,b,a bytes in memory order
+    SimRng rng;                      // own sequence: never touches the world's
+};
+
+ParticleKernel activeParticleKernel();
+void selectParticleKernel(ParticleKernel k);
+const char* particleKernelName(ParticleKernel k);
@@ -0,0 +1,45 @@
+// power_ups.h - structure-of-arrays storage for falling power-up capsules
+// Same layout as the ball pool: one packed column per component and
+// swap-removal, so the fall pass streams through y alone and the catch test
+// reads x and y; the type is only looked at for a capsule the paddle caught.
+// None of it is touched by the ball/brick collision path.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "entity_table.h"
+
+enum class PowerUpType : uint8_t { MULTI_BALL };
+
+struct PowerUpPool {
+    std::vector<float> x, y;            // bottom-left corner
+    std::vector<PowerUpType> type;
+    EntityTable ids;
+    uint32_t count = 0;
+
+    void clear() {
+        x.clear(); y.clear(); type.clear();
+        ids.clear();
+        count = 0;
+    }
+
+    void reserve(uint32_t n) {
+        x.reserve(n); y.reserve(n); type.reserve(n);
+        ids.reserve(n);
+    }
+
+    uint32_t add(float px, float py, PowerUpType t) {
+        x.push_back(px); y.push_back(py); type.push_back(t);
+        ids.create();
+        return count++;
+    }
+
+    void remove(uint32_t i) {
+        uint32_t last = ids.destroy(i);
+        count--;
+        x[i] = x[last]; y[i] = y[last]; type[i] = type[last];
+        x.pop_back(); y.pop_back(); type.pop_back();
+    }
+
+    EntityHandle handle(uint32_t i) const { return ids.handle(i); }
+    uint32_t find(EntityHandle h) const { return ids.find(h); }
+};
@@ -0,0 +1,150 @@
+// profiler.cpp - scoped timers, per-thread event rings, frame overlay data and Chrome traces
+#include "profiler.h"
+#include "spsc_queue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> g_profilerOn{false};
+std::atomic<uint64_t> g_heapAllocs{0};
+
+namespace {
+
+static const size_t RING_EVENTS = 1 << 14;
+
+// Written by its own thread only; read by the thread calling endFrame
+struct ProfileRing {
+    SpscQueue<ProfileEvent, RING_EVENTS> events;
+    std::atomic<uint64_t> dropped{0};
+    uint32_t tid = 0;
+    std::string name;
+};
+
+struct RingRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileRing>> rings;   // never shrinks: rings outlive their threads
+};
+
+RingRegistry& registry() {
+    static RingRegistry r;
+    return r;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+ProfileRing& threadRing() {
+    static thread_local ProfileRing* ring = nullptr;
+    if(!ring) {
+        RingRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.rings.emplace_back(new ProfileRing());
+        ring = reg.rings.back().get();
+        ring->tid = uint32_t(reg.rings.size());
+    }
+    return *ring;
+}
+
+} // namespace
+
+uint64_t profileNow() {
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void profileRecord(const char* name, uint64_t start, uint64_t end) {
+    ProfileRing& ring = threadRing();
+    if(!ring.events.push({name, start, end})) ring.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void profileThreadName(const char* name) {
+    ProfileRing& ring = threadRing();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    ring.name = name;
+}
+
+void FrameProfiler::setEnabled(bool on) {
+    if(on == enabled()) return;
+    g_profilerOn.store(on, std::memory_order_relaxed);
+    // Start the next frame from a clean slate
+    lastFrameEnd = 0;
+    lastAllocs = g_heapAllocs.load(std::memory_order_relaxed);
+    frameTimes.clear();
+    latencies.clear();
+    phaseList.clear();
+}
+
+void FrameProfiler::drain() {
+    for(Phase& p : phaseList) p.lastMs = 0.0;
+    RingRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for(auto& ring : reg.rings) {
+        ProfileEvent e;
+        while(ring->events.pop(e)) {
+            auto it = std::find_if(phaseList.begin(), phaseList.end(), [&](const Phase& p) { return p.name == e.name; });
+            if(it == phaseList.end()) {
+                phaseList.push_back({e.name, 0.0, 0.0});
+                it = phaseList.end() - 1;
+            }
+            it->lastMs += (e.end - e.start) * 1e-6;
+            if(traceOn && trace.size() < (1u << 22)) trace.push_back({e, ring->tid});
+        }
+    }
+    for(Phase& p : phaseList) p.avgMs += (p.lastMs - p.avgMs) * 0.1;
+}
+
+void FrameProfiler::endFrame(const FrameCounters& c) {
+    if(!enabled()) return;
+    uint64_t now = profileNow();
+    if(lastFrameEnd) frameTimes.add(float((now - lastFrameEnd) * 1e-6));
+    if(c.inputLatencyMs >= 0.0) latencies.add(float(c.inputLatencyMs));
+    lastFrameEnd = now;
+    uint64_t allocs = g_heapAllocs.load(std::memory_order_relaxed);
+    counters = c;
+    counters.allocs = allocs - lastAllocs;
+    lastAllocs = allocs;
+    drain();
+}
+
+uint64_t FrameProfiler::droppedEvents() const {
+    uint64_t n = 0;
+    RingRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for(auto& ring : reg.rings) n += ring->dropped.load(std::memory_order_relaxed);
+    return n;
+}
+
+void FrameProfiler::startTrace() {
+    trace.clear();
+    traceOn = true;
+}
+
+// Chrome trace event format: complete ("X") events in microseconds plus
+// thread-name metadata
+bool FrameProfiler::stopTrace(const std::string& path, std::string& error) {
+    traceOn = false;
+    FILE* f = std::fopen(path.c_str(), "w");
+    if(!f) { error = "cannot write " + path; return false; }
+    std::fprintf(f, "{\"traceEvents\":[");
+    const char* sep = "\n";
+    {
+        RingRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for(auto& ring : reg.rings) {
+            std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                         sep, ring->tid, ring->name.empty() ? "worker" : ring->name.c_str());
+            sep = ",\n";
+        }
+    }
+    for(const TraceEvent& t : trace) {
+        std::fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     sep, t.e.name, t.tid, t.e.start * 1e-3, (t.e.end - t.e.start) * 1e-3);
+        sep = ",\n";
+    }
+    std::fprintf(f, "\n]}\n");
+    bool ok = std::fclose(f) == 0;
+    if(!ok) error = "cannot write " + path;
+    trace.clear();
+    trace.shrink_to_fit();
+    return ok;
+}
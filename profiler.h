@@ -0,0 +1,133 @@
+// profiler.h - scoped timers, per-thread event rings, frame overlay data and Chrome traces
+// PROFILE_SCOPE("name") times the enclosing block. While the profiler is off
+// a scope costs one relaxed atomic load; while on, it pushes one event into
+// its thread's lock-free ring (SpscQueue), which the main thread drains once
+// per frame. Build with DXBALL_NO_PROFILER to compile the scopes out.
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ProfileEvent {
+    const char* name;         // string literal: compared by address
+    uint64_t start, end;      // ns since the profiler epoch
+};
+
+extern std::atomic<bool> g_profilerOn;
+// Heap allocations (operator new, counted in frame_arena.cpp) made while the profiler is on
+extern std::atomic<uint64_t> g_heapAllocs;
+
+uint64_t profileNow();
+// Push a finished scope into the calling thread's ring (dropped if full)
+void profileRecord(const char* name, uint64_t start, uint64_t end);
+// Label the calling thread in traces ("main", "mixer", ...)
+void profileThreadName(const char* name);
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* n) : name(g_profilerOn.load(std::memory_order_relaxed) ? n : nullptr) {
+        if(name) start = profileNow();
+    }
+    ~ProfileScope() { if(name) profileRecord(name, start, profileNow()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* name;
+    uint64_t start = 0;
+};
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#ifdef DXBALL_NO_PROFILER
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
+
+// Per-frame counters supplied by the game
+struct FrameCounters {
+    uint32_t drawCalls = 0;
+    uint32_t sounds = 0;
+    uint64_t allocs = 0;      // filled in by FrameProfiler
+    // From the oldest input event this frame is the first to show, to the
+    // buffer swap; negative if the frame shows no new input
+    double inputLatencyMs = -1.0;
+};
+
+// The last N samples, for percentiles
+template<int N>
+struct SampleWindow {
+    float samples[N] = {};
+    int count = 0, at = 0;
+
+    void add(float v) {
+        samples[at] = v;
+        at = (at + 1) % N;
+        if(count < N) count++;
+    }
+    void clear() { count = at = 0; }
+    // percentile in 0..100; 0 when empty
+    float percentile(double p) const;
+};
+
+template<int N>
+float SampleWindow<N>::percentile(double p) const {
+    if(count == 0) return 0.0f;
+    float sorted[N];
+    std::copy(samples, samples + count, sorted);
+    int k = std::min(count - 1, int(p / 100.0 * count));
+    std::nth_element(sorted, sorted + k, sorted + count);
+    return sorted[k];
+}
+
+// Collects the rings once per frame: frame-time history, per-phase totals
+// and, while tracing, every event for a chrome://tracing dump
+class FrameProfiler {
+public:
+    static const int HISTORY = 240;
+
+    struct Phase {
+        const char* name;
+        double lastMs;        // inclusive time in the last frame, all threads
+        double avgMs;         // exponentially smoothed
+    };
+
+    void setEnabled(bool on);
+    bool enabled() const { return g_profilerOn.load(std::memory_order_relaxed); }
+
+    // Call once per displayed frame, after the buffer swap
+    void endFrame(const FrameCounters& counters);
+
+    // Frame time percentile (0..100) over the last HISTORY frames, in ms
+    double frameMs(double percentile) const { return frameTimes.percentile(percentile); }
+    // Input-to-present latency percentile over the last HISTORY samples, in ms
+    double inputLatencyMs(double percentile) const { return latencies.percentile(percentile); }
+    int inputLatencySamples() const { return latencies.count; }
+    const std::vector<Phase>& phases() const { return phaseList; }
+    const FrameCounters& lastCounters() const { return counters; }
+    uint64_t droppedEvents() const;
+
+    // Tracing keeps every drained event until stopTrace writes them out
+    void startTrace();
+    bool tracing() const { return traceOn; }
+    bool stopTrace(const std::string& path, std::string& error);
+
+private:
+    void drain();
+
+    uint64_t lastFrameEnd = 0;
+    uint64_t lastAllocs = 0;
+    SampleWindow<HISTORY> frameTimes;
+    SampleWindow<HISTORY> latencies;
+    std::vector<Phase> phaseList;
+    FrameCounters counters;
+
+    struct TraceEvent {
+        ProfileEvent e;
+        uint32_t tid;
+    };
+    bool traceOn = false;
+    std::vector<TraceEvent> trace;
+};
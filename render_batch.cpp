@@ -0,0 +1,141 @@
+// render_batch.cpp - GL-free render command generation
+#include "render_batch.h"
+#include <cmath>
+#include <algorithm>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static RenderVertex vert(float x, float y, const Color& c) {
+    auto u8 = [](float v) { return uint8_t(std::max(0.0f, std::min(1.0f, v)) * 255.0f + 0.5f); };
+    return RenderVertex{x, y, u8(c.r), u8(c.g), u8(c.b), u8(c.a)};
+}
+
+void RenderBatch::triangle(float x0, float y0, float x1, float y1, float x2, float y2, const Color& c) {
+    triangle(x0, y0, c, x1, y1, c, x2, y2, c);
+}
+
+void RenderBatch::triangle(float x0, float y0, const Color& c0, float x1, float y1, const Color& c1,
+                           float x2, float y2, const Color& c2) {
+    tris.push_back(vert(x0, y0, c0));
+    tris.push_back(vert(x1, y1, c1));
+    tris.push_back(vert(x2, y2, c2));
+}
+
+void RenderBatch::rect(float x0, float y0, float x1, float y1, const Color& c) {
+    triangle(x0, y0, x1, y0, x1, y1, c);
+    triangle(x0, y0, x1, y1, x0, y1, c);
+}
+
+void RenderBatch::thickLine(float x0, float y0, float x1, float y1, float width, const Color& c) {
+    float dx = x1 - x0, dy = y1 - y0;
+    float len = std::sqrt(dx*dx + dy*dy);
+    if(len <= 0.0f) return;
+    float nx = -dy / len * width * 0.5f, ny = dx / len * width * 0.5f;
+    triangle(x0 + nx, y0 + ny, x1 + nx, y1 + ny, x1 - nx, y1 - ny, c);
+    triangle(x0 + nx, y0 + ny, x1 - nx, y1 - ny, x0 - nx, y0 - ny, c);
+}
+
+void RenderBatch::line(float x0, float y0, float x1, float y1, const Color& c) {
+    lines.push_back(vert(x0, y0, c));
+    lines.push_back(vert(x1, y1, c));
+}
+
+// ------------------- Bricks -------------------
+
+void BrickMesh::build(const BrickStore& s) {
+    mesh.clear();
+    mesh.tris.reserve(size_t(s.count) * TRI_VERTS_PER_BRICK);
+    mesh.lines.reserve(size_t(s.count) * LINE_VERTS_PER_BRICK);
+    const Color bevel = {1.0f, 1.0f, 1.0f, 0.08f};
+    const Color outline = {0.02f, 0.02f, 0.02f, 0.7f};
+    for(uint32_t i=0; i<s.count; i++) {
+        float x = s.x[i], y = s.y[i], w = s.w[i], h = s.h[i];
+        // base, then a light top strip to simulate bevel
+        mesh.rect(x, y, x + w, y + h, s.color(i));
+        mesh.rect(x + 2, y + h - 8, x + w - 2, y + h, bevel);
+        mesh.line(x, y, x + w, y, outline);
+        mesh.line(x + w, y, x + w, y + h, outline);
+        mesh.line(x + w, y + h, x, y + h, outline);
+        mesh.line(x, y + h, x, y, outline);
+        if(!s.alive(i)) killBrick(i);
+    }
+    fullUpload = true;
+    dirtyBegin = dirtyEnd = 0;
+}
+
+void BrickMesh::killBrick(uint32_t i) {
+    RenderVertex* t = &mesh.tris[size_t(i) * TRI_VERTS_PER_BRICK];
+    for(uint32_t k=1; k<TRI_VERTS_PER_BRICK; k++) t[k] = t[0];
+    RenderVertex* l = &mesh.lines[size_t(i) * LINE_VERTS_PER_BRICK];
+    for(uint32_t k=1; k<LINE_VERTS_PER_BRICK; k++) l[k] = l[0];
+    if(dirtyEnd <= dirtyBegin) { dirtyBegin = i; dirtyEnd = i + 1; }
+    else { dirtyBegin = std::min(dirtyBegin, i); dirtyEnd = std::max(dirtyEnd, i + 1); }
+}
+
+// ------------------- Ball and paddle -------------------
+
+void ShapeMeshes::build(float padW, float padH) {
+    const int segments = 40;
+    ballUnit.clear();
+    // glossy gradient: center lighter, rim darker (bluish ball)
+    const Color centre = {0.6f, 0.85f, 1.0f, 1.0f};
+    const Color rim = {0.15f, 0.5f, 0.9f, 1.0f};
+    for(int i=0;i<segments;i++){
+        float a0 = 2.0f * M_PI * float(i) / float(segments);
+        float a1 = 2.0f * M_PI * float(i+1) / float(segments);
+        ballUnit.triangle(0, 0, centre, cosf(a0), sinf(a0), rim, cosf(a1), sinf(a1), rim);
+    }
+    // subtle bright highlight
+    const Color gloss = {1.0f, 1.0f, 1.0f, 0.35f};
+    for(int i=0;i<16;i++){
+        float a0 = M_PI * float(i) / 16.0f;
+        float a1 = M_PI * float(i+1) / 16.0f;
+        ballUnit.triangle(-0.3f, 0.35f, -0.3f + cosf(a0)*0.35f, 0.35f + sinf(a0)*0.35f,
+                          -0.3f + cosf(a1)*0.35f, 0.35f + sinf(a1)*0.35f, gloss);
+    }
+    // outline
+    const Color edge = {0.03f, 0.08f, 0.15f, 1.0f};
+    for(int i=0;i<segments;i++){
+        float a0 = 2.0f * M_PI * float(i) / float(segments);
+        float a1 = 2.0f * M_PI * float(i+1) / float(segments);
+        ballUnit.line(cosf(a0), sinf(a0), cosf(a1), sinf(a1), edge);
+    }
+
+    // Paddle: green base, glossy top strip, light stripes, 2 px outline
+    paddle.clear();
+    float w = padW, h = padH;
+    paddle.rect(0, 0, w, h, {0.12f, 0.7f, 0.3f, 1.0f});
+    paddle.rect(2, h-6, w-2, h-2, {1.0f, 1.0f, 1.0f, 0.12f});
+    for(float sx = 12.0f; sx < w - 12.0f; sx += 24.0f) {
+        paddle.thickLine(sx, 6.0f, sx+10.0f, h-6.0f, 2.0f, {0.9f, 0.95f, 0.9f, 0.25f});
+    }
+    const Color outline = {0.02f, 0.05f, 0.03f, 1.0f};
+    paddle.rect(-1, -1, w+1, 1, outline);
+    paddle.rect(-1, h-1, w+1, h+1, outline);
+    paddle.rect(-1, 1, 1, h-1, outline);
+    paddle.rect(w-1, 1, w+1, h-1, outline);
+}
+
+static void appendTransformed(std::vector<RenderVertex>& out, const std::vector<RenderVertex>& src,
+                              float ox, float oy, float scale) {
+    size_t base = out.size();
+    out.resize(base + src.size());
+    for(size_t i=0; i<src.size(); i++) {
+        RenderVertex v = src[i];
+        v.x = ox + v.x * scale;
+        v.y = oy + v.y * scale;
+        out[base + i] = v;
+    }
+}
+
+void ShapeMeshes::appendBall(RenderBatch& out, float cx, float cy, float r) const {
+    appendTransformed(out.tris, ballUnit.tris, cx, cy, r);
+    appendTransformed(out.lines, ballUnit.lines, cx, cy, r);
+}
+
+void ShapeMeshes::appendPaddle(RenderBatch& out, float x, float y) const {
+    appendTransformed(out.tris, paddle.tris, x, y, 1.0f);
+    appendTransformed(out.lines, paddle.lines, x, y, 1.0f);
+}
@@ -0,0 +1,73 @@
+// render_batch.h - GL-free render command generation
+// Geometry is collected into flat vertex arrays (one triangle list, one line
+// list) that the GL side draws with a single call each. Nothing here touches
+// GL, so the same code runs headless (benchmarks, CI).
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "brick_store.h"
+
+struct RenderVertex {
+    float x, y;
+    uint8_t r, g, b, a;
+};
+
+struct RenderStats {
+    uint32_t drawCalls = 0;
+    uint32_t vertices = 0;
+    void reset() { drawCalls = 0; vertices = 0; }
+};
+
+struct RenderBatch {
+    std::vector<RenderVertex> tris;    // GL_TRIANGLES
+    std::vector<RenderVertex> lines;   // GL_LINES, 1 px wide
+
+    void clear() { tris.clear(); lines.clear(); }
+
+    void triangle(float x0, float y0, float x1, float y1, float x2, float y2, const Color& c);
+    void triangle(float x0, float y0, const Color& c0, float x1, float y1, const Color& c1,
+                  float x2, float y2, const Color& c2);
+    // axis-aligned rectangle from (x0,y0) to (x1,y1)
+    void rect(float x0, float y0, float x1, float y1, const Color& c);
+    // a line of the given width as two triangles (no end caps, like glLineWidth)
+    void thickLine(float x0, float y0, float x1, float y1, float width, const Color& c);
+    void line(float x0, float y0, float x1, float y1, const Color& c);
+};
+
+// Brick geometry for a whole level: built once, patched in place when a
+// brick dies (its vertices collapse to a point, so the draw stays one call).
+class BrickMesh {
+public:
+    static const uint32_t TRI_VERTS_PER_BRICK = 12;    // base + bevel strip
+    static const uint32_t LINE_VERTS_PER_BRICK = 8;    // outline
+
+    void build(const BrickStore& s);
+    void killBrick(uint32_t i);
+
+    const RenderBatch& batch() const { return mesh; }
+
+    // Vertex ranges changed since the last markUploaded(); rebuilt() means
+    // the whole mesh has to go up again.
+    bool rebuilt() const { return fullUpload; }
+    bool dirty() const { return fullUpload || dirtyEnd > dirtyBegin; }
+    uint32_t dirtyBrickBegin() const { return dirtyBegin; }
+    uint32_t dirtyBrickEnd() const { return dirtyEnd; }
+    void markUploaded() { fullUpload = false; dirtyBegin = dirtyEnd = 0; }
+
+private:
+    RenderBatch mesh;
+    bool fullUpload = true;
+    uint32_t dirtyBegin = 0, dirtyEnd = 0;
+};
+
+// Ball and paddle meshes built once and only translated/scaled per frame
+class ShapeMeshes {
+public:
+    void build(float padW, float padH);
+    void appendBall(RenderBatch& out, float cx, float cy, float r) const;
+    void appendPaddle(RenderBatch& out, float x, float y) const;
+
+private:
+    RenderBatch ballUnit;   // radius 1 around the origin
+    RenderBatch paddle;     // bottom-left corner at the origin
+};
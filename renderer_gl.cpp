@@ -0,0 +1,111 @@
+// renderer_gl.cpp - draws RenderBatch geometry with as few GL calls as possible
+#include "renderer_gl.h"
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+#include <cstddef>
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_STATIC_DRAW  0x88E4
+#define GL_STREAM_DRAW  0x88E0
+#endif
+
+typedef void (APIENTRY *GenBuffersFn)(GLsizei, GLuint*);
+typedef void (APIENTRY *BindBufferFn)(GLenum, GLuint);
+typedef void (APIENTRY *BufferDataFn)(GLenum, ptrdiff_t, const void*, GLenum);
+typedef void (APIENTRY *BufferSubDataFn)(GLenum, ptrdiff_t, ptrdiff_t, const void*);
+
+static GenBuffersFn pGenBuffers = nullptr;
+static BindBufferFn pBindBuffer = nullptr;
+static BufferDataFn pBufferData = nullptr;
+static BufferSubDataFn pBufferSubData = nullptr;
+
+void GLBatchRenderer::init() {
+    const char* ver = (const char*)glGetString(GL_VERSION);
+    bool gl15 = ver && (ver[0] > '1' || (ver[0] == '1' && ver[2] >= '5'));
+    if(gl15) {
+        pGenBuffers = (GenBuffersFn)glutGetProcAddress("glGenBuffers");
+        pBindBuffer = (BindBufferFn)glutGetProcAddress("glBindBuffer");
+        pBufferData = (BufferDataFn)glutGetProcAddress("glBufferData");
+        pBufferSubData = (BufferSubDataFn)glutGetProcAddress("glBufferSubData");
+    }
+    vboOk = pGenBuffers && pBindBuffer && pBufferData && pBufferSubData;
+    if(vboOk) {
+        GLuint ids[5];
+        pGenBuffers(5, ids);
+        brickTriVbo = ids[0]; brickLineVbo = ids[1];
+        dynTriVbo = ids[2]; dynLineVbo = ids[3];
+        pointVbo = ids[4];
+    }
+}
+
+void GLBatchRenderer::drawArrays(unsigned buffer, const RenderVertex* client, unsigned mode, size_t count, RenderStats& stats) {
+    if(count == 0) return;
+    const char* base = (const char*)client;
+    if(vboOk) {
+        pBindBuffer(GL_ARRAY_BUFFER, buffer);
+        base = nullptr;
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(RenderVertex), base + offsetof(RenderVertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RenderVertex), base + offsetof(RenderVertex, r));
+    glDrawArrays(mode, 0, GLsizei(count));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if(vboOk) pBindBuffer(GL_ARRAY_BUFFER, 0);
+    stats.drawCalls++;
+    stats.vertices += uint32_t(count);
+}
+
+void GLBatchRenderer::drawBricks(BrickMesh& mesh, RenderStats& stats) {
+    const RenderBatch& b = mesh.batch();
+    if(vboOk && mesh.dirty()) {
+        if(mesh.rebuilt()) {
+            pBindBuffer(GL_ARRAY_BUFFER, brickTriVbo);
+            pBufferData(GL_ARRAY_BUFFER, b.tris.size() * sizeof(RenderVertex), b.tris.data(), GL_STATIC_DRAW);
+            pBindBuffer(GL_ARRAY_BUFFER, brickLineVbo);
+            pBufferData(GL_ARRAY_BUFFER, b.lines.size() * sizeof(RenderVertex), b.lines.data(), GL_STATIC_DRAW);
+        } else {
+            // only the bricks that died since the last frame
+            size_t t0 = size_t(mesh.dirtyBrickBegin()) * BrickMesh::TRI_VERTS_PER_BRICK;
+            size_t t1 = size_t(mesh.dirtyBrickEnd()) * BrickMesh::TRI_VERTS_PER_BRICK;
+            pBindBuffer(GL_ARRAY_BUFFER, brickTriVbo);
+            pBufferSubData(GL_ARRAY_BUFFER, t0 * sizeof(RenderVertex), (t1 - t0) * sizeof(RenderVertex), &b.tris[t0]);
+            size_t l0 = size_t(mesh.dirtyBrickBegin()) * BrickMesh::LINE_VERTS_PER_BRICK;
+            size_t l1 = size_t(mesh.dirtyBrickEnd()) * BrickMesh::LINE_VERTS_PER_BRICK;
+            pBindBuffer(GL_ARRAY_BUFFER, brickLineVbo);
+            pBufferSubData(GL_ARRAY_BUFFER, l0 * sizeof(RenderVertex), (l1 - l0) * sizeof(RenderVertex), &b.lines[l0]);
+        }
+        pBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    mesh.markUploaded();
+    drawArrays(brickTriVbo, b.tris.data(), GL_TRIANGLES, b.tris.size(), stats);
+    glLineWidth(1.0f);
+    drawArrays(brickLineVbo, b.lines.data(), GL_LINES, b.lines.size(), stats);
+}
+
+void GLBatchRenderer::drawDynamic(const RenderBatch& b, RenderStats& stats) {
+    if(vboOk) {
+        pBindBuffer(GL_ARRAY_BUFFER, dynTriVbo);
+        pBufferData(GL_ARRAY_BUFFER, b.tris.size() * sizeof(RenderVertex), b.tris.data(), GL_STREAM_DRAW);
+        pBindBuffer(GL_ARRAY_BUFFER, dynLineVbo);
+        pBufferData(GL_ARRAY_BUFFER, b.lines.size() * sizeof(RenderVertex), b.lines.data(), GL_STREAM_DRAW);
+        pBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    drawArrays(dynTriVbo, b.tris.data(), GL_TRIANGLES, b.tris.size(), stats);
+    glLineWidth(1.0f);
+    drawArrays(dynLineVbo, b.lines.data(), GL_LINES, b.lines.size(), stats);
+}
+
+void GLBatchRenderer::drawPoints(const std::vector<RenderVertex>& points, float size, RenderStats& stats) {
+    if(points.empty()) return;
+    if(vboOk) {
+        pBindBuffer(GL_ARRAY_BUFFER, pointVbo);
+        pBufferData(GL_ARRAY_BUFFER, points.size() * sizeof(RenderVertex), points.data(), GL_STREAM_DRAW);
+        pBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glPointSize(size);
+    drawArrays(pointVbo, points.data(), GL_POINTS, points.size(), stats);
+    glPointSize(1.0f);
+}
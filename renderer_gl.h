@@ -0,0 +1,28 @@
+// renderer_gl.h - draws RenderBatch geometry with as few GL calls as possible
+// Uses vertex buffer objects when the driver exposes them (GL 1.5, looked up
+// through glutGetProcAddress) and plain client-side vertex arrays otherwise,
+// so it also runs on a bare GL 1.1 opengl32 and on Mesa's software GL.
+#pragma once
+#include "render_batch.h"
+
+class GLBatchRenderer {
+public:
+    // Call once a GL context exists
+    void init();
+    bool usingVbo() const { return vboOk; }
+
+    // Level bricks: uploads only the vertex ranges that changed, two draw calls
+    void drawBricks(BrickMesh& mesh, RenderStats& stats);
+    // Per-frame geometry (ball, paddle, ...): streamed, two draw calls at most
+    void drawDynamic(const RenderBatch& batch, RenderStats& stats);
+    // Square points of one size (particles): streamed, one draw call
+    void drawPoints(const std::vector<RenderVertex>& points, float size, RenderStats& stats);
+
+private:
+    void drawArrays(unsigned buffer, const RenderVertex* client, unsigned mode, size_t count, RenderStats& stats);
+
+    bool vboOk = false;
+    unsigned brickTriVbo = 0, brickLineVbo = 0;
+    unsigned dynTriVbo = 0, dynLineVbo = 0;
+    unsigned pointVbo = 0;
+};
@@ -0,0 +1,288 @@
+// replay.cpp - compact per-tick input recording and deterministic replay
+#include "replay.h"
+#include "lz4_block.h"
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+static const char REPLAY_MAGIC[4] = {'D','X','R','P'};
+static const uint32_t REPLAY_VERSION = 2;   // 2 added the physics mode
+
+// Record flags (low 5 bits of the leading varint; the rest is the tick delta)
+enum : uint32_t {
+    IN_LAUNCH     = 1,
+    IN_MOVE       = 2,     // new padMove follows as a raw float
+    IN_MOVE_SAME  = 4,     // padMove equals the last one sent
+    IN_TARGET     = 8,     // whole-pixel padTarget follows as a zigzag delta
+    IN_TARGET_RAW = 16,    // fractional padTarget follows as a raw float
+};
+static const int FLAG_BITS = 5;
+
+// ------------------- Encoding helpers -------------------
+
+static void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while(v >= 0x80) { out.push_back(uint8_t(v | 0x80)); v >>= 7; }
+    out.push_back(uint8_t(v));
+}
+
+static bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& v) {
+    v = 0;
+    for(int shift=0; shift<64; shift+=7) {
+        if(pos >= in.size()) return false;
+        uint8_t b = in[pos++];
+        v |= uint64_t(b & 0x7F) << shift;
+        if(!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+static int64_t unzigzag(uint64_t v) { return int64_t(v >> 1) ^ -int64_t(v & 1); }
+
+static void putFloat(std::vector<uint8_t>& out, float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, 4);
+    for(int i=0;i<4;i++) out.push_back(uint8_t(u >> (8*i)));
+}
+
+static bool getFloat(const std::vector<uint8_t>& in, size_t& pos, float& f) {
+    if(in.size() - pos < 4) return false;
+    uint32_t u = 0;
+    for(int i=0;i<4;i++) u |= uint32_t(in[pos++]) << (8*i);
+    std::memcpy(&f, &u, 4);
+    return true;
+}
+
+// ------------------- World setup and hashing -------------------
+
+bool setupReplayWorld(const ReplayHeader& h, GameWorld& w, PreparedLevel* prepared) {
+    int rows = 0, cols = 0;
+    char tail = 0;
+    bool generated = std::sscanf(h.level.c_str(), "%dx%d%c", &rows, &cols, &tail) == 2;
+    if(generated && (rows < 1 || cols < 1)) return false;
+    PreparedLevel loaded;
+    if(!generated && !prepared) {
+        std::string error;
+        if(!prepareLevelFile(h.level, 0.0f, float(WIN_H), loaded, error)) return false;
+        prepared = &loaded;
+    }
+    if(!generated && h.physics == PhysicsMode::FIXED && !fitsFixedPoint(prepared->bricks)) return false;
+    w.reseed(h.seed);
+    w.padSpeed = h.padSpeed;
+    w.paddleDeflect = h.paddleDeflect;
+    w.powerUpChance = h.powerUpChance;
+    w.physics = h.physics;
+    if(generated) w.resetLevel(rows, cols);
+    else w.loadLevel(std::move(*prepared));
+    return true;
+}
+
+uint32_t worldStateHash(const GameWorld& w) {
+    uint32_t h = 2166136261u;
+    auto mix = [&](const void* p, size_t n) {
+        const uint8_t* b = static_cast<const uint8_t*>(p);
+        for(size_t i=0; i<n; i++) { h ^= b[i]; h *= 16777619u; }
+    };
+    const BallPool& b = w.balls;
+    mix(&w.padX, sizeof(w.padX));
+    mix(&b.count, sizeof(b.count));
+    mix(b.x.data(), b.count * sizeof(float));
+    mix(b.y.data(), b.count * sizeof(float));
+    mix(b.vx.data(), b.count * sizeof(float));
+    mix(b.vy.data(), b.count * sizeof(float));
+    uint8_t flags[2] = {uint8_t(w.ballStuckToPaddle), uint8_t(w.round)};
+    mix(flags, sizeof(flags));
+    mix(&w.score, sizeof(w.score));
+    mix(&w.lives, sizeof(w.lives));
+    mix(w.bricks.aliveBits.data(), w.bricks.aliveBits.size() * sizeof(uint64_t));
+    for(uint32_t i=0; i<w.powerUps.count; i++) { mix(&w.powerUps.x[i], sizeof(float)); mix(&w.powerUps.y[i], sizeof(float)); }
+    mix(&w.rng.state, sizeof(w.rng.state));
+    return h;
+}
+
+// ------------------- Recording -------------------
+
+void ReplayRecorder::begin(const ReplayHeader& h) {
+    rec = Replay();
+    rec.header = h;
+    // room for a long round up front, so recording doesn't reallocate mid-play
+    rec.inputs.reserve(1 << 18);
+    rec.hashes.reserve(1 << 12);
+    started = true;
+    lastInputTick = 0;
+    lastMove = 0.0f;
+    lastTarget = 0;
+}
+
+void ReplayRecorder::tick(const GameInput& in, const GameWorld& after) {
+    if(!started) return;
+    uint32_t t = ++rec.ticks;
+    rec.finalScore = after.score;
+    if(rec.header.hashInterval && t % rec.header.hashInterval == 0) rec.hashes.push_back(worldStateHash(after));
+    if(in.padMove == 0.0f && !in.hasPadTarget && !in.launch) return;
+
+    uint32_t flags = 0;
+    if(in.launch) flags |= IN_LAUNCH;
+    if(in.padMove != 0.0f) flags |= (in.padMove == lastMove) ? IN_MOVE_SAME : IN_MOVE;
+    int32_t whole = 0;
+    if(in.hasPadTarget) {
+        whole = int32_t(std::lround(in.padTarget));
+        flags |= (float(whole) == in.padTarget && std::fabs(in.padTarget) < 1e7f) ? IN_TARGET : IN_TARGET_RAW;
+    }
+    putVarint(rec.inputs, (uint64_t(t - lastInputTick) << FLAG_BITS) | flags);
+    lastInputTick = t;
+    if(flags & IN_MOVE) { putFloat(rec.inputs, in.padMove); }
+    if(in.padMove != 0.0f) lastMove = in.padMove;
+    if(flags & IN_TARGET) { putVarint(rec.inputs, zigzag(int64_t(whole) - lastTarget)); lastTarget = whole; }
+    if(flags & IN_TARGET_RAW) putFloat(rec.inputs, in.padTarget);
+}
+
+// ------------------- Playback -------------------
+
+bool ReplayReader::readRecord() {
+    uint64_t v;
+    if(!getVarint(rep.inputs, pos, v)) return false;
+    uint32_t flags = uint32_t(v) & ((1u << FLAG_BITS) - 1);
+    uint64_t delta = v >> FLAG_BITS;
+    if(delta == 0 || delta > rep.ticks) return false;
+    pending = GameInput();
+    pending.launch = (flags & IN_LAUNCH) != 0;
+    if(flags & IN_MOVE) {
+        if(!getFloat(rep.inputs, pos, lastMove)) return false;
+        pending.padMove = lastMove;
+    } else if(flags & IN_MOVE_SAME) {
+        pending.padMove = lastMove;
+    }
+    if(flags & IN_TARGET) {
+        uint64_t z;
+        if(!getVarint(rep.inputs, pos, z)) return false;
+        lastTarget = int32_t(lastTarget + unzigzag(z));
+        pending.hasPadTarget = true;
+        pending.padTarget = float(lastTarget);
+    } else if(flags & IN_TARGET_RAW) {
+        if(!getFloat(rep.inputs, pos, pending.padTarget)) return false;
+        pending.hasPadTarget = true;
+    }
+    lastInputTick += uint32_t(delta);
+    havePending = true;
+    return true;
+}
+
+bool ReplayReader::next(GameInput& in) {
+    if(bad) return false;
+    tick++;
+    in = GameInput();
+    if(!havePending && pos < rep.inputs.size() && !readRecord()) { bad = true; return false; }
+    if(havePending && lastInputTick == tick) {
+        in = pending;
+        havePending = false;
+    }
+    return true;
+}
+
+ReplayResult runReplay(const Replay& r, GameWorld& w) {
+    ReplayResult res;
+    if(!setupReplayWorld(r.header, w)) { res.mismatchTick = 0; return res; }
+    float dt = r.header.stepSeconds;
+    ReplayReader reader(r);
+    uint32_t interval = r.header.hashInterval;
+    for(uint32_t t=1; t<=r.ticks; t++) {
+        GameInput in;
+        if(!reader.next(in)) { res.mismatchTick = t; break; }
+        w.step(in, dt);
+        res.ticks = t;
+        if(interval && t % interval == 0) {
+            size_t k = t / interval - 1;
+            if(k >= r.hashes.size() || r.hashes[k] != worldStateHash(w)) { res.mismatchTick = t; break; }
+        }
+    }
+    res.score = w.score;
+    if(res.ok() && res.score != r.finalScore) res.mismatchTick = res.ticks;
+    return res;
+}
+
+// ------------------- Files -------------------
+
+bool saveReplay(const char* path, const Replay& r) {
+    std::vector<uint8_t> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    putVarint(out, REPLAY_VERSION);
+    putVarint(out, r.header.seed);
+    putVarint(out, r.header.level.size());
+    out.insert(out.end(), r.header.level.begin(), r.header.level.end());
+    putFloat(out, r.header.stepSeconds);
+    putFloat(out, r.header.padSpeed);
+    putFloat(out, r.header.paddleDeflect);
+    putFloat(out, r.header.powerUpChance);
+    putVarint(out, r.header.hashInterval);
+    putVarint(out, uint64_t(r.header.physics));
+    putVarint(out, r.ticks);
+    putVarint(out, zigzag(r.finalScore));
+
+    std::vector<uint8_t> packed;
+    bool lz4 = !r.inputs.empty() &&
+               lz4CompressBlock(r.inputs.data(), r.inputs.size(), packed) < r.inputs.size();
+    putVarint(out, r.inputs.size());
+    out.push_back(lz4 ? 1 : 0);
+    const std::vector<uint8_t>& body = lz4 ? packed : r.inputs;
+    putVarint(out, body.size());
+    out.insert(out.end(), body.begin(), body.end());
+
+    putVarint(out, r.hashes.size());
+    for(uint32_t h : r.hashes) for(int i=0;i<4;i++) out.push_back(uint8_t(h >> (8*i)));
+
+    std::FILE* f = std::fopen(path, "wb");
+    if(!f) return false;
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool loadReplay(const char* path, Replay& r) {
+    std::FILE* f = std::fopen(path, "rb");
+    if(!f) return false;
+    std::vector<uint8_t> in;
+    uint8_t buf[4096];
+    size_t n;
+    while((n = std::fread(buf, 1, sizeof(buf), f)) > 0) in.insert(in.end(), buf, buf + n);
+    std::fclose(f);
+
+    r = Replay();
+    if(in.size() < 4 || std::memcmp(in.data(), REPLAY_MAGIC, 4) != 0) return false;
+    size_t pos = 4;
+    uint64_t version, seed, levelLen, interval, physics = 0, ticks, score, rawSize, storedSize, hashCount;
+    if(!getVarint(in, pos, version) || version < 1 || version > REPLAY_VERSION) return false;
+    if(!getVarint(in, pos, seed) || !getVarint(in, pos, levelLen) || in.size() - pos < levelLen) return false;
+    r.header.seed = seed;
+    r.header.level.assign(in.begin() + pos, in.begin() + pos + levelLen);
+    pos += levelLen;
+    if(!getFloat(in, pos, r.header.stepSeconds) || !getFloat(in, pos, r.header.padSpeed) ||
+       !getFloat(in, pos, r.header.paddleDeflect) || !getFloat(in, pos, r.header.powerUpChance)) return false;
+    if(!getVarint(in, pos, interval)) return false;
+    if(version >= 2 && (!getVarint(in, pos, physics) || physics > uint64_t(PhysicsMode::FIXED))) return false;
+    if(!getVarint(in, pos, ticks) || !getVarint(in, pos, score)) return false;
+    r.header.physics = PhysicsMode(physics);
+    if(!(r.header.stepSeconds > 0.0f && r.header.stepSeconds <= 1.0f) || ticks > 0xFFFFFFFFu) return false;
+    r.header.hashInterval = uint32_t(interval);
+    r.ticks = uint32_t(ticks);
+    r.finalScore = int32_t(unzigzag(score));
+
+    if(!getVarint(in, pos, rawSize) || pos >= in.size()) return false;
+    uint8_t codec = in[pos++];
+    if(!getVarint(in, pos, storedSize) || in.size() - pos < storedSize || rawSize > (uint64_t(1) << 30)) return false;
+    if(codec == 1) {
+        r.inputs.resize(size_t(rawSize));
+        if(!lz4DecompressBlock(in.data() + pos, size_t(storedSize), r.inputs.data(), r.inputs.size())) return false;
+    } else if(codec == 0 && storedSize == rawSize) {
+        r.inputs.assign(in.begin() + pos, in.begin() + pos + storedSize);
+    } else {
+        return false;
+    }
+    pos += storedSize;
+
+    if(!getVarint(in, pos, hashCount) || (in.size() - pos) / 4 < hashCount) return false;
+    r.hashes.resize(size_t(hashCount));
+    for(auto& h : r.hashes) {
+        h = uint32_t(in[pos]) | uint32_t(in[pos+1]) << 8 | uint32_t(in[pos+2]) << 16 | uint32_t(in[pos+3]) << 24;
+        pos += 4;
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+// replay.h - compact per-tick input recording and deterministic replay
+// A round is fully determined by its start parameters (seed, level, tuning)
+// and the GameInput fed to each step, so that is all a replay stores.
+// Ticks with no input cost nothing; the rest are one varint of
+// (ticks since the last input, flags) plus the changed values, with mouse
+// targets delta-coded. A state hash every `hashInterval` ticks lets a replay
+// prove it re-simulated the same game.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "game_world.h"
+#include "level.h"
+
+struct ReplayHeader {
+    uint64_t seed = 1;
+    std::string level = "4x8";           // rows x cols for GameWorld::resetLevel, or a level file
+    float stepSeconds = 1.0f / DEFAULT_SIM_HZ;   // the exact dt passed to step()
+    float padSpeed = 15.0f;
+    float paddleDeflect = PADDLE_DEFLECT;
+    float powerUpChance = 0.1f;
+    uint32_t hashInterval = 240;
+    PhysicsMode physics = PhysicsMode::FLOAT;
+};
+
+// Reseed, apply the tuning and build the level; false if `level` is not
+// understood, or reaches past the fixed-point range in FIXED. A level that isn't "RxC" is loaded from disk unless the caller
+// already has it in `prepared` (consumed).
+bool setupReplayWorld(const ReplayHeader& h, GameWorld& w, PreparedLevel* prepared = nullptr);
+
+// FNV-1a over everything the simulation carries from tick to tick
+uint32_t worldStateHash(const GameWorld& w);
+
+struct Replay {
+    ReplayHeader header;
+    uint32_t ticks = 0;
+    int32_t finalScore = 0;
+    std::vector<uint8_t> inputs;         // encoded input stream
+    std::vector<uint32_t> hashes;        // after tick hashInterval, 2*hashInterval, ...
+};
+
+class ReplayRecorder {
+public:
+    void begin(const ReplayHeader& h);
+    // After each world.step(in, dt)
+    void tick(const GameInput& in, const GameWorld& after);
+    const Replay& replay() const { return rec; }
+    bool active() const { return started; }
+
+private:
+    Replay rec;
+    bool started = false;
+    uint32_t lastInputTick = 0;
+    float lastMove = 0.0f;
+    int32_t lastTarget = 0;
+};
+
+// Writes the input stream LZ4-compressed when that is smaller
+bool saveReplay(const char* path, const Replay& r);
+bool loadReplay(const char* path, Replay& r);
+
+// Decodes the input stream one tick at a time
+class ReplayReader {
+public:
+    explicit ReplayReader(const Replay& r) : rep(r) {}
+    // Input for the next tick; false once the stream is malformed
+    bool next(GameInput& in);
+
+private:
+    bool readRecord();
+
+    const Replay& rep;
+    size_t pos = 0;
+    uint32_t tick = 0, lastInputTick = 0;
+    bool havePending = false;
+    GameInput pending;
+    float lastMove = 0.0f;
+    int32_t lastTarget = 0;
+    bool bad = false;
+};
+
+struct ReplayResult {
+    uint32_t ticks = 0;
+    int64_t mismatchTick = -1;           // first tick whose hash differed, or -1
+    int32_t score = 0;
+    bool ok() const { return mismatchTick < 0; }
+};
+
+// Re-simulate the whole replay headless, checking every stored hash
+ReplayResult runReplay(const Replay& r, GameWorld& w);
@@ -0,0 +1,134 @@
+// rollback.cpp - two boards stepped in lockstep with predicted remote input
+#include "rollback.h"
+#include <algorithm>
+
+static bool sameInput(const GameInput& a, const GameInput& b) {
+    return a.padMove == b.padMove && a.hasPadTarget == b.hasPadTarget && a.launch == b.launch &&
+           (!a.hasPadTarget || a.padTarget == b.padTarget);
+}
+
+void RollbackSession::start(GameWorld* board0, GameWorld* board1, int localPlayer, float stepDt,
+                            uint32_t inputDelay, uint32_t maxPrediction) {
+    boards[0] = board0;
+    boards[1] = board1;
+    local = localPlayer;
+    dt = stepDt;
+    delay = std::min(inputDelay, ROLLBACK_RING / 4);
+    maxAhead = std::max(1u, std::min(maxPrediction, ROLLBACK_RING / 4));
+    current = confirmed = 0;
+    firstWrong = UINT32_MAX;
+    std::fill(localIn, localIn + ROLLBACK_RING, GameInput());
+    std::fill(remoteFrame, remoteFrame + ROLLBACK_RING, UINT32_MAX);
+    localEnd = delay;            // the first frames run on empty local input
+    lastRemote = GameInput();
+    for(Check& c : localChecks) c = Check();
+    for(Check& c : remoteChecks) c = Check();
+    lastCheckFrame = UINT32_MAX;
+    nextCheck = 0;
+    desync = -1;
+    st = RollbackStats();
+}
+
+// Counts the local input the caller queues before advancing: with no input
+// delay, frame `current` has no local input until then
+bool RollbackSession::canAdvance() const {
+    return localEnd + 1 > current && current < confirmed + maxAhead;
+}
+
+void RollbackSession::addLocalInput(const GameInput& in) {
+    if(localEnd - current >= ROLLBACK_RING / 2) return;
+    localIn[localEnd % ROLLBACK_RING] = in;
+    localEnd++;
+}
+
+void RollbackSession::addRemoteInput(uint32_t f, const GameInput& in) {
+    if(f < confirmed || f >= confirmed + ROLLBACK_RING / 2) return;
+    uint32_t slot = f % ROLLBACK_RING;
+    if(remoteFrame[slot] == f) return;
+    remoteFrame[slot] = f;
+    remoteIn[slot] = in;
+    if(f < current && !sameInput(in, remoteUsed[slot])) firstWrong = std::min(firstWrong, f);
+    while(remoteFrame[confirmed % ROLLBACK_RING] == confirmed) {
+        lastRemote = remoteIn[confirmed % ROLLBACK_RING];
+        confirmed++;
+    }
+}
+
+void RollbackSession::simulate(uint32_t f) {
+    uint32_t slot = f % ROLLBACK_RING;
+    saveSnapshot(*boards[0], snaps[slot][0]);
+    saveSnapshot(*boards[1], snaps[slot][1]);
+    GameInput remote;
+    if(remoteFrame[slot] == f) {
+        remote = remoteIn[slot];
+    } else {
+        remote = lastRemote;
+        remote.launch = false;
+    }
+    remoteUsed[slot] = remote;
+    boards[local]->step(localIn[slot], dt);
+    boards[1 - local]->step(remote, dt);
+}
+
+void RollbackSession::repair() {
+    if(firstWrong < current) {
+        uint32_t slot = firstWrong % ROLLBACK_RING;
+        // A board that won't take its snapshot back can't be repaired;
+        // re-simulating on top of the present would diverge silently
+        if(!restoreSnapshot(*boards[0], snaps[slot][0]) || !restoreSnapshot(*boards[1], snaps[slot][1])) {
+            if(desync < 0) desync = firstWrong;
+            firstWrong = UINT32_MAX;
+            return;
+        }
+        for(uint32_t f=firstWrong; f<current; f++) simulate(f);
+        st.rollbacks++;
+        st.resimulatedFrames += current - firstWrong;
+        st.maxDepth = std::max(st.maxDepth, current - firstWrong);
+    }
+    firstWrong = UINT32_MAX;
+}
+
+bool RollbackSession::advance() {
+    if(localEnd <= current || current >= confirmed + maxAhead) return false;
+    repair();
+    updateChecksums();
+    simulate(current);
+    current++;
+    return true;
+}
+
+// The state after frame c is the snapshot taken before c + 1; it is final
+// once every input up to c is real and c + 1 has been (re)simulated
+void RollbackSession::updateChecksums() {
+    while(nextCheck + 1 < current && nextCheck < confirmed) {
+        const WorldSnapshot* s = snaps[(nextCheck + 1) % ROLLBACK_RING];
+        uint32_t hash = snapshotHash(s[0]) ^ (snapshotHash(s[1]) * 0x9E3779B1u);
+        Check& c = localChecks[(nextCheck / ROLLBACK_CHECK_INTERVAL) % 4];
+        c.frame = nextCheck;
+        c.hash = hash;
+        lastCheckFrame = nextCheck;
+        compareChecks(nextCheck);
+        nextCheck += ROLLBACK_CHECK_INTERVAL;
+    }
+}
+
+bool RollbackSession::checksum(uint32_t f, uint32_t& hash) const {
+    const Check& c = localChecks[(f / ROLLBACK_CHECK_INTERVAL) % 4];
+    if(c.frame != f) return false;
+    hash = c.hash;
+    return true;
+}
+
+void RollbackSession::addRemoteChecksum(uint32_t f, uint32_t hash) {
+    if(f % ROLLBACK_CHECK_INTERVAL != 0) return;
+    Check& c = remoteChecks[(f / ROLLBACK_CHECK_INTERVAL) % 4];
+    c.frame = f;
+    c.hash = hash;
+    compareChecks(f);
+}
+
+void RollbackSession::compareChecks(uint32_t f) {
+    const Check& a = localChecks[(f / ROLLBACK_CHECK_INTERVAL) % 4];
+    const Check& b = remoteChecks[(f / ROLLBACK_CHECK_INTERVAL) % 4];
+    if(a.frame == f && b.frame == f && a.hash != b.hash && desync < 0) desync = f;
+}
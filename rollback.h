@@ -0,0 +1,90 @@
+// rollback.h - two boards stepped in lockstep with predicted remote input
+// Each peer simulates both boards: its own from local input (delayed by
+// inputDelay frames, which hides that much network latency) and the rival's
+// from the rival's inputs as they arrive. A frame whose remote input hasn't
+// arrived yet is simulated with a prediction (the last input received,
+// without the launch). When the real input turns out different, both boards
+// are restored to the snapshot taken before that frame and re-simulated up
+// to the present. The session stalls rather than predict more than
+// maxPrediction frames ahead of the last confirmed remote input.
+#pragma once
+#include <cstdint>
+#include "game_world.h"
+#include "snapshot.h"
+
+static const uint32_t ROLLBACK_RING = 64;          // frames of inputs and snapshots kept
+static const uint32_t ROLLBACK_CHECK_INTERVAL = 30; // frames between state checksums
+
+struct RollbackStats {
+    uint64_t rollbacks = 0;
+    uint64_t resimulatedFrames = 0;
+    uint32_t maxDepth = 0;
+};
+
+class RollbackSession {
+public:
+    // board[p] is driven by player p; both must be set up identically on the two peers
+    void start(GameWorld* board0, GameWorld* board1, int localPlayer, float dt,
+               uint32_t inputDelay = 2, uint32_t maxPrediction = 8);
+
+    // True if advance() would simulate a frame once this frame's local input
+    // is queued (the caller checks, adds the input, then advances)
+    bool canAdvance() const;
+    // Queue this frame's local input (it applies inputDelay frames later);
+    // call once before each successful advance()
+    void addLocalInput(const GameInput& in);
+    // A real input of the remote player (duplicates and old frames are ignored)
+    void addRemoteInput(uint32_t frame, const GameInput& in);
+    // Repair mispredictions, then simulate the next frame; false on a stall
+    bool advance();
+    // Just the repair: re-simulate from the earliest mispredicted frame. A
+    // snapshot that won't restore sets desyncFrame() instead.
+    void repair();
+
+    uint32_t frame() const { return current; }
+    // Every frame below this was (or will be) simulated with real remote input
+    uint32_t remoteConfirmed() const { return confirmed; }
+    // Local inputs exist for frames below this
+    uint32_t localInputEnd() const { return localEnd; }
+    const GameInput& localInput(uint32_t f) const { return localIn[f % ROLLBACK_RING]; }
+    int localPlayer() const { return local; }
+
+    // State checksum after frame f (f % ROLLBACK_CHECK_INTERVAL == 0) once
+    // it is final; peers compare them to detect a desync
+    bool checksum(uint32_t f, uint32_t& hash) const;
+    uint32_t latestChecksumFrame() const { return lastCheckFrame; }
+    // The other peer's checksum; a mismatch sets desyncFrame()
+    void addRemoteChecksum(uint32_t f, uint32_t hash);
+    int64_t desyncFrame() const { return desync; }
+
+    const RollbackStats& stats() const { return st; }
+
+private:
+    void simulate(uint32_t f);
+    void updateChecksums();
+    void compareChecks(uint32_t f);
+
+    GameWorld* boards[2] = {nullptr, nullptr};
+    int local = 0;
+    float dt = 1.0f / 60.0f;
+    uint32_t delay = 2, maxAhead = 8;
+
+    uint32_t current = 0;             // next frame to simulate
+    uint32_t localEnd = 0;
+    uint32_t confirmed = 0;
+    uint32_t firstWrong = UINT32_MAX; // earliest simulated frame with a wrong prediction
+    GameInput localIn[ROLLBACK_RING];
+    GameInput remoteIn[ROLLBACK_RING];
+    GameInput remoteUsed[ROLLBACK_RING];
+    uint32_t remoteFrame[ROLLBACK_RING];   // frame number stored in remoteIn's slot, or UINT32_MAX
+    GameInput lastRemote;
+    WorldSnapshot snaps[ROLLBACK_RING][2]; // both boards before frame f
+
+    // The last few checksums, ours and the other peer's, by frame
+    struct Check { uint32_t frame = UINT32_MAX, hash = 0; };
+    Check localChecks[4], remoteChecks[4];
+    uint32_t lastCheckFrame = UINT32_MAX;
+    uint32_t nextCheck = 0;
+    int64_t desync = -1;
+    RollbackStats st;
+};
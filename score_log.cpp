@@ -0,0 +1,166 @@
+// score_log.cpp - persistent append-only score log and a maintained top-K board
+#include "score_log.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char SCORE_MAGIC[8] = {'D','X','S','C','O','R','E','1'};
+
+// ------------------- Top-K -------------------
+
+void TopScores::insert(const std::string& name, int score) {
+    uint64_t order = total++;
+    auto pos = std::find_if(best.begin(), best.end(), [&](const ScoreEntry& e) {
+        if(e.score != score) return e.score < score;
+        return name < e.name;
+    });
+    if(size_t(pos - best.begin()) >= k) return;
+    best.insert(pos, {name, score, order});
+    if(best.size() > k) best.pop_back();
+}
+
+// ------------------- Record framing -------------------
+// u8 payload length | payload | u32 CRC-32 of the payload
+// payload: u8 kind | u8 slot | i32 score | name bytes
+
+static uint32_t crc32(const uint8_t* p, size_t n) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if(!ready) {
+        for(uint32_t i=0; i<256; i++) {
+            uint32_t c = i;
+            for(int k=0; k<8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    uint32_t c = 0xFFFFFFFFu;
+    for(size_t i=0; i<n; i++) c = table[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+static std::vector<uint8_t> encodeRecord(const ScoreRecord& r) {
+    size_t nameLen = std::min<size_t>(r.name.size(), 255 - 6);
+    std::vector<uint8_t> out;
+    out.reserve(1 + 6 + nameLen + 4);
+    out.push_back(uint8_t(6 + nameLen));
+    out.push_back(uint8_t(r.kind));
+    out.push_back(r.slot);
+    for(int i=0;i<4;i++) out.push_back(uint8_t(uint32_t(r.score) >> (8*i)));
+    out.insert(out.end(), r.name.begin(), r.name.begin() + nameLen);
+    uint32_t c = crc32(out.data() + 1, out.size() - 1);
+    for(int i=0;i<4;i++) out.push_back(uint8_t(c >> (8*i)));
+    return out;
+}
+
+// ------------------- Log -------------------
+
+bool ScoreLog::open(const std::string& path, const std::function<void(const ScoreRecord&)>& onRecord) {
+    close();
+    loaded = torn = 0;
+
+    std::vector<uint8_t> bytes;
+    std::error_code ec;
+    if(std::FILE* in = std::fopen(path.c_str(), "rb")) {
+        uint8_t buf[4096];
+        size_t n;
+        while((n = std::fread(buf, 1, sizeof(buf), in)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+        std::fclose(in);
+    } else if(std::filesystem::exists(path, ec)) {
+        return false;
+    }
+
+    size_t good = 0;
+    if(bytes.size() >= sizeof(SCORE_MAGIC) && std::memcmp(bytes.data(), SCORE_MAGIC, sizeof(SCORE_MAGIC)) == 0) {
+        good = sizeof(SCORE_MAGIC);
+        while(good < bytes.size()) {
+            size_t len = bytes[good];
+            if(len < 6 || bytes.size() - good < 1 + len + 4) break;
+            const uint8_t* p = &bytes[good + 1];
+            uint32_t stored = 0;
+            for(int i=0;i<4;i++) stored |= uint32_t(p[len + i]) << (8*i);
+            if(crc32(p, len) != stored || p[0] > uint8_t(ScoreKind::BEST)) break;
+            ScoreRecord r;
+            r.kind = ScoreKind(p[0]);
+            r.slot = p[1];
+            r.score = int32_t(uint32_t(p[2]) | uint32_t(p[3]) << 8 | uint32_t(p[4]) << 16 | uint32_t(p[5]) << 24);
+            r.name.assign(reinterpret_cast<const char*>(p + 6), len - 6);
+            onRecord(r);
+            loaded++;
+            good += 1 + len + 4;
+        }
+    }
+    torn = bytes.size() - std::min(good, bytes.size());
+
+    // Cut a torn tail so new records follow intact ones. Only a missing or
+    // empty file (or one torn inside the magic) is started over: anything
+    // else isn't a score log and is left alone.
+    if(good == 0) {
+        if(bytes.size() >= sizeof(SCORE_MAGIC)) return false;
+        if(!bytes.empty() && std::memcmp(bytes.data(), SCORE_MAGIC, bytes.size()) != 0) return false;
+        file = std::fopen(path.c_str(), "wb");
+        if(file && std::fwrite(SCORE_MAGIC, 1, sizeof(SCORE_MAGIC), file) != sizeof(SCORE_MAGIC)) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    } else {
+        if(good < bytes.size()) std::filesystem::resize_file(path, good, ec);
+        file = ec ? nullptr : std::fopen(path.c_str(), "ab");
+    }
+    if(!file) return false;
+
+    quit = false;
+    writer = std::thread(&ScoreLog::writerLoop, this);
+    return true;
+}
+
+void ScoreLog::append(const ScoreRecord& r) {
+    if(!file) return;
+    std::vector<uint8_t> rec = encodeRecord(r);
+    {
+        std::lock_guard<std::mutex> lock(m);
+        queue.push_back(std::move(rec));
+    }
+    cv.notify_one();
+}
+
+void ScoreLog::writerLoop() {
+    std::vector<std::vector<uint8_t>> batch;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return quit || !queue.empty(); });
+            if(queue.empty()) return;    // quit with nothing left
+            batch.swap(queue);
+        }
+        for(const auto& rec : batch) std::fwrite(rec.data(), 1, rec.size(), file);
+        std::fflush(file);
+        // push to the disk, not just the OS cache, before the next batch
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+        batch.clear();
+    }
+}
+
+void ScoreLog::close() {
+    if(writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            quit = true;
+        }
+        cv.notify_one();
+        writer.join();
+    }
+    if(file) std::fclose(file);
+    file = nullptr;
+    queue.clear();
+}
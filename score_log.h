@@ -0,0 +1,78 @@
+// score_log.h - persistent append-only score log and a maintained top-K board
+// Every finished run (and every new per-player best) is one small framed,
+// CRC-checked record appended to the log. A crash can at worst tear the last
+// record, which open() detects and cuts off. Appends are handed to a writer
+// thread, so the game never waits on the disk. The board shown in the menu
+// is a sorted top-K array updated in O(K) per run, never re-sorted.
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ScoreKind : uint8_t { RUN = 0, BEST = 1 };
+
+struct ScoreRecord {
+    ScoreKind kind = ScoreKind::RUN;
+    uint8_t slot = 0;        // player slot (0..2)
+    int32_t score = 0;
+    std::string name;        // at most 255 bytes are stored
+};
+
+struct ScoreEntry {
+    std::string name;
+    int score;
+    uint64_t order;          // insertion order; earlier runs win ties
+};
+
+class TopScores {
+public:
+    explicit TopScores(size_t k = 12) : k(k) { best.reserve(k + 1); }
+
+    // Highest score first, then name, then the earlier run
+    void insert(const std::string& name, int score);
+    const std::vector<ScoreEntry>& entries() const { return best; }
+    uint64_t totalRuns() const { return total; }
+
+private:
+    size_t k;
+    std::vector<ScoreEntry> best;
+    uint64_t total = 0;
+};
+
+class ScoreLog {
+public:
+    ScoreLog() = default;
+    ScoreLog(const ScoreLog&) = delete;
+    ScoreLog& operator=(const ScoreLog&) = delete;
+    ~ScoreLog() { close(); }
+
+    // Replay every intact record through onRecord (on this thread), drop a
+    // torn tail, then start the writer thread appending to the same file.
+    // A missing or empty file becomes a new log; false, leaving the file
+    // untouched, if it holds anything but a score log.
+    bool open(const std::string& path, const std::function<void(const ScoreRecord&)>& onRecord);
+    // Queue a record; returns immediately
+    void append(const ScoreRecord& r);
+    // Write out everything queued and stop the writer
+    void close();
+
+    bool isOpen() const { return writer.joinable(); }
+    uint64_t recordsLoaded() const { return loaded; }
+    uint64_t droppedBytes() const { return torn; }
+
+private:
+    void writerLoop();
+
+    std::FILE* file = nullptr;
+    std::thread writer;
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<std::vector<uint8_t>> queue;
+    bool quit = false;
+    uint64_t loaded = 0, torn = 0;
+};
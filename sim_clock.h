@@ -0,0 +1,43 @@
+// sim_clock.h - fixed-timestep accumulator driven by a monotonic clock
+// Simulation always advances in steps of exactly `dt`; whatever is left over
+// between steps becomes the render interpolation factor alpha().
+#pragma once
+#include <chrono>
+
+inline double monotonicSeconds() {
+    using clk = std::chrono::steady_clock;
+    static const clk::time_point start = clk::now();
+    return std::chrono::duration<double>(clk::now() - start).count();
+}
+
+struct FixedStepClock {
+    double dt = 1.0 / 120.0;   // simulation step, seconds
+    int maxSubsteps = 8;       // per displayed frame, so a long stall can't snowball
+    double accumulator = 0.0;
+    double lastTime = -1.0;
+
+    void setRate(double hz) { dt = 1.0 / hz; accumulator = 0.0; }
+
+    // Forget elapsed time (after a pause or a state change)
+    void reset(double now) { lastTime = now; accumulator = 0.0; }
+
+    // Add wall time since the previous call; returns how many steps to run now
+    int advance(double now) {
+        if(lastTime < 0.0) lastTime = now;
+        double frame = now - lastTime;
+        lastTime = now;
+        if(frame > 0.25) frame = 0.25;
+        accumulator += frame;
+        int steps = 0;
+        while(accumulator >= dt && steps < maxSubsteps) {
+            accumulator -= dt;
+            steps++;
+        }
+        // Behind by more than maxSubsteps: drop the backlog instead of catching up
+        if(accumulator >= dt) accumulator = 0.0;
+        return steps;
+    }
+
+    // Fraction of a step between the last simulated state and "now"
+    float alpha() const { return float(accumulator / dt); }
+};
@@ -0,0 +1,162 @@
+// snapshot.cpp - the whole round state of a GameWorld as one flat byte buffer
+#include "snapshot.h"
+#include <cstring>
+
+namespace {
+
+// Fixed part; the variable-length arrays follow in this order:
+// balls x, y, vx, vy, r, prevX, prevY | power-ups x, y, type |
+// ball handles | power-up handles | alive bits | hp | aliveBricks | aliveSlot
+struct SnapshotHeader {
+    uint32_t size;            // whole snapshot, bytes
+    uint32_t brickCount;
+    uint32_t ballCount;
+    uint32_t powerUpCount;
+    uint32_t ballSlots, ballFree;         // EntityTable sizes
+    uint32_t powerUpSlots, powerUpFree;
+    uint32_t aliveCount;
+    uint32_t bricksNotResident;
+    uint32_t bricksOnScreen;
+    float scrollY;            // a snapshot only restores at the scroll it was taken at
+    uint64_t rngState;
+    float padX, prevPadX, padW, padH, padY;
+    float padSpeed, paddleDeflect, ballSize;
+    int32_t lives, score;
+    uint8_t round, ballStuckToPaddle, floorBounces, physics;
+};
+
+template<class T>
+inline uint8_t* put(uint8_t* p, const T* v, size_t n) {
+    if(n) std::memcpy(p, v, n * sizeof(T));
+    return p + n * sizeof(T);
+}
+
+template<class T>
+inline const uint8_t* get(const uint8_t* p, std::vector<T>& v, size_t n) {
+    v.resize(n);
+    if(n) std::memcpy(v.data(), p, n * sizeof(T));
+    return p + n * sizeof(T);
+}
+
+// owner has one entry per row; rowOf and gen one per slot
+size_t tableBytes(const EntityTable& t) {
+    return (t.owner.size() + 2 * t.rowOf.size() + t.freeSlots.size()) * sizeof(uint32_t);
+}
+
+uint8_t* putTable(uint8_t* p, const EntityTable& t) {
+    p = put(p, t.owner.data(), t.owner.size());
+    p = put(p, t.rowOf.data(), t.rowOf.size());
+    p = put(p, t.gen.data(), t.gen.size());
+    return put(p, t.freeSlots.data(), t.freeSlots.size());
+}
+
+const uint8_t* getTable(const uint8_t* p, EntityTable& t, uint32_t rows, uint32_t slots, uint32_t free) {
+    p = get(p, t.owner, rows);
+    p = get(p, t.rowOf, slots);
+    p = get(p, t.gen, slots);
+    return get(p, t.freeSlots, free);
+}
+
+} // namespace
+
+void saveSnapshot(const GameWorld& w, WorldSnapshot& out) {
+    const BallPool& b = w.balls;
+    const PowerUpPool& u = w.powerUps;
+    const BrickStore& s = w.bricks;
+    size_t words = s.aliveBits.size();
+    size_t size = sizeof(SnapshotHeader) + size_t(b.count) * 7 * sizeof(float) +
+                  size_t(u.count) * (2 * sizeof(float) + sizeof(PowerUpType)) +
+                  tableBytes(b.ids) + tableBytes(u.ids) + words * sizeof(uint64_t) + s.count +
+                  (w.aliveBricks.size() + w.aliveSlot.size()) * sizeof(uint32_t);
+    out.bytes.resize(size);
+
+    SnapshotHeader h;
+    std::memset(&h, 0, sizeof(h));
+    h.size = uint32_t(size);
+    h.brickCount = s.count;
+    h.ballCount = b.count;
+    h.powerUpCount = u.count;
+    h.ballSlots = uint32_t(b.ids.rowOf.size()); h.ballFree = uint32_t(b.ids.freeSlots.size());
+    h.powerUpSlots = uint32_t(u.ids.rowOf.size()); h.powerUpFree = uint32_t(u.ids.freeSlots.size());
+    h.aliveCount = uint32_t(w.aliveBricks.size());
+    h.bricksNotResident = w.bricksNotResident;
+    h.bricksOnScreen = w.bricksOnScreen;
+    h.scrollY = w.scrollY;
+    h.rngState = w.rng.state;
+    h.padX = w.padX; h.prevPadX = w.prevPadX; h.padW = w.padW; h.padH = w.padH; h.padY = w.padY;
+    h.padSpeed = w.padSpeed; h.paddleDeflect = w.paddleDeflect; h.ballSize = w.ballSize;
+    h.lives = w.lives; h.score = w.score;
+    h.round = uint8_t(w.round);
+    h.ballStuckToPaddle = w.ballStuckToPaddle;
+    h.floorBounces = w.floorBounces;
+    h.physics = uint8_t(w.physics);
+
+    uint8_t* p = out.bytes.data();
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    p = put(p, b.x.data(), b.count);
+    p = put(p, b.y.data(), b.count);
+    p = put(p, b.vx.data(), b.count);
+    p = put(p, b.vy.data(), b.count);
+    p = put(p, b.r.data(), b.count);
+    p = put(p, b.prevX.data(), b.count);
+    p = put(p, b.prevY.data(), b.count);
+    p = put(p, u.x.data(), u.count);
+    p = put(p, u.y.data(), u.count);
+    p = put(p, u.type.data(), u.count);
+    p = putTable(p, b.ids);
+    p = putTable(p, u.ids);
+    p = put(p, s.aliveBits.data(), words);
+    p = put(p, s.hp.data(), s.count);
+    p = put(p, w.aliveBricks.data(), w.aliveBricks.size());
+    put(p, w.aliveSlot.data(), w.aliveSlot.size());
+}
+
+bool restoreSnapshot(GameWorld& w, const WorldSnapshot& snap) {
+    if(snap.bytes.size() < sizeof(SnapshotHeader)) return false;
+    SnapshotHeader h;
+    std::memcpy(&h, snap.bytes.data(), sizeof(h));
+    BrickStore& s = w.bricks;
+    if(h.size != snap.bytes.size() || h.brickCount != s.count || h.scrollY != w.scrollY) return false;
+
+    w.rng.state = h.rngState;
+    w.padX = h.padX; w.prevPadX = h.prevPadX; w.padW = h.padW; w.padH = h.padH; w.padY = h.padY;
+    w.padSpeed = h.padSpeed; w.paddleDeflect = h.paddleDeflect; w.ballSize = h.ballSize;
+    w.lives = h.lives; w.score = h.score;
+    w.round = RoundState(h.round);
+    w.ballStuckToPaddle = h.ballStuckToPaddle != 0;
+    w.floorBounces = h.floorBounces != 0;
+    w.physics = PhysicsMode(h.physics);
+    w.bricksNotResident = h.bricksNotResident;
+    w.bricksOnScreen = h.bricksOnScreen;
+
+    BallPool& b = w.balls;
+    PowerUpPool& u = w.powerUps;
+    const uint8_t* p = snap.bytes.data() + sizeof(h);
+    b.count = h.ballCount;
+    p = get(p, b.x, b.count);
+    p = get(p, b.y, b.count);
+    p = get(p, b.vx, b.count);
+    p = get(p, b.vy, b.count);
+    p = get(p, b.r, b.count);
+    p = get(p, b.prevX, b.count);
+    p = get(p, b.prevY, b.count);
+    u.count = h.powerUpCount;
+    p = get(p, u.x, u.count);
+    p = get(p, u.y, u.count);
+    p = get(p, u.type, u.count);
+    p = getTable(p, b.ids, b.count, h.ballSlots, h.ballFree);
+    p = getTable(p, u.ids, u.count, h.powerUpSlots, h.powerUpFree);
+    p = get(p, s.aliveBits, s.aliveBits.size());
+    p = get(p, s.hp, s.count);
+    p = get(p, w.aliveBricks, h.aliveCount);
+    get(p, w.aliveSlot, w.aliveSlot.size());
+    w.events.clear();
+    return true;
+}
+
+uint32_t snapshotHash(const WorldSnapshot& s) {
+    uint32_t h = 2166136261u;
+    for(uint8_t c : s.bytes) { h ^= c; h *= 16777619u; }
+    return h;
+}
@@ -0,0 +1,25 @@
+// snapshot.h - the whole round state of a GameWorld as one flat byte buffer
+// Everything step() reads and writes is copied: paddle, balls and power-ups
+// (with their entity handles), brick alive bits and hit points, the
+// alive-brick index, score, lives, round state and the RNG. Brick geometry,
+// palette and grid are fixed for a level and stay out, so a snapshot
+// restores into the world (or an identically loaded one) it was taken from,
+// at the scroll position it was taken at.
+// The buffer keeps its capacity, so after the first save neither call
+// allocates.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "game_world.h"
+
+struct WorldSnapshot {
+    std::vector<uint8_t> bytes;
+
+    bool empty() const { return bytes.empty(); }
+};
+
+void saveSnapshot(const GameWorld& w, WorldSnapshot& out);
+// False (and `w` untouched) if the snapshot is for another brick layout
+bool restoreSnapshot(GameWorld& w, const WorldSnapshot& s);
+// FNV-1a over the bytes, for comparing states between peers
+uint32_t snapshotHash(const WorldSnapshot& s);
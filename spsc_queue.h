@@ -0,0 +1,37 @@
+// spsc_queue.h - bounded lock-free single-producer/single-consumer queue
+// One thread pushes, one thread pops; no locks, no allocation after
+// construction. Capacity must be a power of two.
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+template<class T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+public:
+    // Producer side. Returns false (and drops the item) when full.
+    bool push(const T& v) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) == N) return false;
+        slots[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& out) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if(t == head.load(std::memory_order_acquire)) return false;
+        out = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const { return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire); }
+
+private:
+    T slots[N];
+    // separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
@@ -0,0 +1,80 @@
+// text_batch.cpp - GL-free text layout against a glyph atlas
+#include "text_batch.h"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+static uint8_t toByte(float v) { return uint8_t(std::max(0.0f, std::min(1.0f, v)) * 255.0f + 0.5f); }
+
+float FontMetrics::width(const char* s) const {
+    float w = 0.0f;
+    for(; *s; s++) w += glyph(*s)->advance;
+    return w;
+}
+
+void layoutText(const FontMetrics& font, float x, float y, const char* s, const Color& c,
+                std::vector<TextVertex>& out) {
+    uint8_t r = toByte(c.r), g = toByte(c.g), b = toByte(c.b), a = toByte(c.a);
+    float pen = x;
+    for(; *s; s++) {
+        const GlyphInfo& gi = *font.glyph(*s);
+        float x0 = pen + gi.ox, y0 = y + gi.oy;
+        float x1 = x0 + gi.w, y1 = y0 + gi.h;
+        if(*s != ' ') {
+            TextVertex q[4] = {
+                {x0, y0, gi.u0, gi.v0, r, g, b, a},
+                {x1, y0, gi.u1, gi.v0, r, g, b, a},
+                {x1, y1, gi.u1, gi.v1, r, g, b, a},
+                {x0, y1, gi.u0, gi.v1, r, g, b, a},
+            };
+            out.push_back(q[0]); out.push_back(q[1]); out.push_back(q[2]);
+            out.push_back(q[0]); out.push_back(q[2]); out.push_back(q[3]);
+        }
+        pen += gi.advance;
+    }
+}
+
+void TextLabel::relayout(const FontMetrics& font, const Color& c) {
+    verts.clear();
+    if(font.ready) layoutText(font, px, py, str.c_str(), c, verts);
+    laidOutWith = &font;
+    fontWasReady = font.ready;
+    col = c;
+    layoutCount++;
+}
+
+void TextLabel::recolor(const Color& c) {
+    uint8_t r = toByte(c.r), g = toByte(c.g), b = toByte(c.b), a = toByte(c.a);
+    for(auto& v : verts) { v.r = r; v.g = g; v.b = b; v.a = a; }
+    col = c;
+}
+
+void TextLabel::set(const FontMetrics& font, float x, float y, const char* prefix, const char* s, const Color& c) {
+    size_t np = std::strlen(prefix), ns = std::strlen(s);
+    bool same = str.size() == np + ns &&
+                str.compare(0, np, prefix) == 0 && str.compare(np, ns, s) == 0;
+    if(numberPrefix || laidOutWith != &font || fontWasReady != font.ready || x != px || y != py || !same) {
+        numberPrefix = nullptr;
+        str.assign(prefix);
+        str.append(s);
+        px = x; py = y;
+        relayout(font, c);
+    } else if(c.r != col.r || c.g != col.g || c.b != col.b || c.a != col.a) {
+        recolor(c);
+    }
+}
+
+void TextLabel::setNumber(const FontMetrics& font, float x, float y, const char* prefix, int value, const Color& c) {
+    if(laidOutWith != &font || fontWasReady != font.ready || x != px || y != py ||
+       numberPrefix != prefix || value != number) {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%s%d", prefix, value);
+        str = buf;
+        numberPrefix = prefix;
+        number = value;
+        px = x; py = y;
+        relayout(font, c);
+    } else if(c.r != col.r || c.g != col.g || c.b != col.b || c.a != col.a) {
+        recolor(c);
+    }
+}
@@ -0,0 +1,76 @@
+// text_batch.h - GL-free text layout against a glyph atlas
+// Glyph metrics come from the atlas the GL side rasterizes once at startup;
+// a string becomes one run of textured quads. TextLabel keeps the laid-out
+// run and only redoes it when its text or value actually changes.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "brick_store.h"
+
+struct TextVertex {
+    float x, y;
+    float u, v;
+    uint8_t r, g, b, a;
+};
+
+static const int GLYPH_FIRST = 32;
+static const int GLYPH_LAST  = 126;
+
+struct GlyphInfo {
+    float u0, v0, u1, v1;   // atlas texture coordinates
+    float w, h;             // quad size in pixels
+    float ox, oy;           // quad offset from the pen position (baseline)
+    float advance;
+};
+
+struct FontMetrics {
+    GlyphInfo glyphs[GLYPH_LAST - GLYPH_FIRST + 1];
+    bool ready = false;
+
+    const GlyphInfo* glyph(char ch) const {
+        int c = (unsigned char)ch;
+        if(c < GLYPH_FIRST || c > GLYPH_LAST) c = '?';
+        return &glyphs[c - GLYPH_FIRST];
+    }
+    float width(const char* s) const;
+};
+
+// Append the quads for `s` with the pen starting at (x, y) on the baseline
+void layoutText(const FontMetrics& font, float x, float y, const char* s, const Color& c,
+                std::vector<TextVertex>& out);
+
+class TextLabel {
+public:
+    // Lay out `s` again only if the text, font or position changed (colour is
+    // patched in place)
+    void set(const FontMetrics& font, float x, float y, const char* s, const Color& c) {
+        set(font, x, y, "", s, c);
+    }
+    // "prefix" followed by `s`, compared piecewise so nothing is concatenated per frame
+    void set(const FontMetrics& font, float x, float y, const char* prefix, const char* s, const Color& c);
+    // "prefix<value>"; formats the number only when the value changes
+    void setNumber(const FontMetrics& font, float x, float y, const char* prefix, int value, const Color& c);
+
+    const std::vector<TextVertex>& vertices() const { return verts; }
+    const std::string& text() const { return str; }
+    const Color& color() const { return col; }
+    float x() const { return px; }
+    float y() const { return py; }
+    // how many times the run was rebuilt (for stats)
+    uint32_t layouts() const { return layoutCount; }
+
+private:
+    void relayout(const FontMetrics& font, const Color& c);
+    void recolor(const Color& c);
+
+    std::string str;
+    std::vector<TextVertex> verts;
+    const FontMetrics* laidOutWith = nullptr;
+    const char* numberPrefix = nullptr;
+    int number = 0;
+    bool fontWasReady = false;
+    float px = 0, py = 0;
+    Color col = {1,1,1,1};
+    uint32_t layoutCount = 0;
+};
@@ -0,0 +1,145 @@
+// text_renderer_gl.cpp - glyph-atlas text drawing for the GLUT bitmap fonts
+#include "text_renderer_gl.h"
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+#include <cstddef>
+
+static const int ATLAS_W = 512;
+static const int ATLAS_H = 512;
+
+static void* fontHandle(int i) {
+    switch(i) {
+        case 0: return GLUT_BITMAP_HELVETICA_18;
+        case 1: return GLUT_BITMAP_TIMES_ROMAN_24;
+        default: return GLUT_BITMAP_9_BY_15;
+    }
+}
+
+const FontMetrics& GLTextRenderer::metrics(void* glutFont) const {
+    for(int i=0; i<FONT_COUNT; i++) {
+        if(fontHandle(i) == glutFont) return fonts[i];
+    }
+    return missing;
+}
+
+bool GLTextRenderer::buildAtlas() {
+    if(attempted) return atlasReady;
+    attempted = true;
+
+    GLint vp[4];
+    glGetIntegerv(GL_VIEWPORT, vp);
+    if(vp[2] < ATLAS_W || vp[3] < ATLAS_H) return false;
+
+    // Draw every glyph white-on-black in pixel space at its atlas position
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, vp[2], 0, vp[3], -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+    glDisable(GL_BLEND);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glColor3f(1, 1, 1);
+
+    bool fits = true;
+    int penX = 0, penY = 0, rowH = 0;
+    for(int f=0; f<FONT_COUNT && fits; f++) {
+        void* font = fontHandle(f);
+        int fh = glutBitmapHeight(font);
+        int desc = fh/4 + 2;              // room below the baseline
+        int cellH = fh + 4;
+        for(int c=GLYPH_FIRST; c<=GLYPH_LAST; c++) {
+            int adv = glutBitmapWidth(font, c);
+            int cellW = adv + 4;          // 2 px either side for overhanging glyphs
+            if(penX + cellW > ATLAS_W) { penX = 0; penY += rowH; rowH = 0; }
+            if(penY + cellH > ATLAS_H) { fits = false; break; }
+            glRasterPos2i(penX + 2, penY + desc);
+            glutBitmapCharacter(font, c);
+
+            GlyphInfo& g = fonts[f].glyphs[c - GLYPH_FIRST];
+            g.u0 = float(penX) / ATLAS_W;          g.v0 = float(penY) / ATLAS_H;
+            g.u1 = float(penX + cellW) / ATLAS_W;  g.v1 = float(penY + cellH) / ATLAS_H;
+            g.w = float(cellW); g.h = float(cellH);
+            g.ox = -2.0f; g.oy = -float(desc);
+            g.advance = float(adv);
+            penX += cellW;
+            if(cellH > rowH) rowH = cellH;
+        }
+        penX = 0; penY += rowH; rowH = 0;
+    }
+
+    std::vector<unsigned char> pixels;
+    if(fits) {
+        pixels.resize(size_t(ATLAS_W) * ATLAS_H);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadBuffer(GL_BACK);
+        glReadPixels(vp[0], vp[1], ATLAS_W, ATLAS_H, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    }
+    glClear(GL_COLOR_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    if(!fits) return false;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_W, ATLAS_H, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    for(int f=0; f<FONT_COUNT; f++) fonts[f].ready = true;
+    atlasReady = true;
+    return true;
+}
+
+void GLTextRenderer::drawRun(const std::vector<TextVertex>& v, RenderStats& stats) {
+    if(v.empty()) return;
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    const char* base = (const char*)v.data();
+    glVertexPointer(2, GL_FLOAT, sizeof(TextVertex), base + offsetof(TextVertex, x));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(TextVertex), base + offsetof(TextVertex, u));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(TextVertex), base + offsetof(TextVertex, r));
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(v.size()));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+    stats.drawCalls++;
+    stats.vertices += uint32_t(v.size());
+}
+
+void GLTextRenderer::drawBitmap(float x, float y, const char* s, void* glutFont, const Color& c, RenderStats& stats) {
+    glColor4f(c.r, c.g, c.b, c.a);
+    glRasterPos2f(x, y);
+    for(; *s; s++) {
+        glutBitmapCharacter(glutFont, *s);
+        stats.drawCalls++;
+    }
+}
+
+void GLTextRenderer::drawText(float x, float y, const char* s, void* glutFont, const Color& c, RenderStats& stats) {
+    const FontMetrics& m = metrics(glutFont);
+    if(!m.ready) { drawBitmap(x, y, s, glutFont, c, stats); return; }
+    scratch.clear();
+    layoutText(m, x, y, s, c, scratch);
+    drawRun(scratch, stats);
+}
+
+void GLTextRenderer::drawLabel(const TextLabel& label, void* glutFont, RenderStats& stats) {
+    if(!metrics(glutFont).ready) {
+        drawBitmap(label.x(), label.y(), label.text().c_str(), glutFont, label.color(), stats);
+        return;
+    }
+    drawRun(label.vertices(), stats);
+}
@@ -0,0 +1,34 @@
+// text_renderer_gl.h - glyph-atlas text drawing for the GLUT bitmap fonts
+// The fonts in use are rasterized once with glutBitmapCharacter, read back
+// into a single alpha texture, and every string is then drawn as one run of
+// textured quads instead of one glBitmap call per character.
+#pragma once
+#include "text_batch.h"
+#include "render_batch.h"
+
+class GLTextRenderer {
+public:
+    // Rasterize the atlas. Reads glyphs back from the back buffer, so it
+    // must run inside the display callback of a visible window; only the
+    // first call does any work. Falls back to glutBitmapCharacter on failure.
+    bool buildAtlas();
+    bool ready() const { return atlasReady; }
+
+    // Metrics for a GLUT bitmap font handle (GLUT_BITMAP_HELVETICA_18, ...)
+    const FontMetrics& metrics(void* glutFont) const;
+
+    void drawText(float x, float y, const char* s, void* glutFont, const Color& c, RenderStats& stats);
+    void drawLabel(const TextLabel& label, void* glutFont, RenderStats& stats);
+
+private:
+    void drawRun(const std::vector<TextVertex>& v, RenderStats& stats);
+    void drawBitmap(float x, float y, const char* s, void* glutFont, const Color& c, RenderStats& stats);
+
+    static const int FONT_COUNT = 3;
+    FontMetrics fonts[FONT_COUNT];
+    FontMetrics missing;            // stays !ready: unknown font handle
+    unsigned texture = 0;
+    bool attempted = false;
+    bool atlasReady = false;
+    std::vector<TextVertex> scratch;
+};
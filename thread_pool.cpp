@@ -0,0 +1,126 @@
+// thread_pool.cpp - small work-stealing thread pool
+#include "thread_pool.h"
+#include <algorithm>
+
+// Which pool/worker the current thread belongs to (submit() stays local)
+static thread_local const ThreadPool* t_pool = nullptr;
+static thread_local unsigned t_index = 0;
+
+void ThreadPool::TaskRing::pushBack(Task&& t) {
+    if(count == slots.size()) {
+        std::vector<Task> grown(std::max<size_t>(8, slots.size() * 2));
+        for(size_t i=0; i<count; i++) grown[i] = std::move(slots[(head + i) % slots.size()]);
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + count) % slots.size()] = std::move(t);
+    count++;
+}
+
+void ThreadPool::TaskRing::popBack(Task& out) {
+    Task& slot = slots[(head + count - 1) % slots.size()];
+    out = std::move(slot);
+    slot = nullptr;
+    count--;
+}
+
+void ThreadPool::TaskRing::popFront(Task& out) {
+    out = std::move(slots[head]);
+    slots[head] = nullptr;
+    head = (head + 1) % slots.size();
+    count--;
+}
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for(unsigned i=0; i<threads; i++) workers.emplace_back(new Worker());
+    for(unsigned i=0; i<threads; i++) workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit.store(true);
+    }
+    workCv.notify_all();
+    for(auto& w : workers) w->thread.join();
+}
+
+void ThreadPool::submit(Task task) {
+    unsigned target = (t_pool == this) ? t_index
+                                       : nextWorker.fetch_add(1, std::memory_order_relaxed) % size();
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->m);
+        workers[target]->tasks.pushBack(std::move(task));
+    }
+    {
+        // under the sleep lock so a worker can't miss the wake-up between its check and wait
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1);
+    }
+    workCv.notify_one();
+}
+
+bool ThreadPool::popLocal(unsigned index, Task& out) {
+    Worker& w = *workers[index];
+    std::lock_guard<std::mutex> lock(w.m);
+    if(w.tasks.empty()) return false;
+    w.tasks.popBack(out);
+    queued.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::steal(unsigned thief, Task& out) {
+    unsigned n = size();
+    for(unsigned k=1; k<=n; k++) {
+        Worker& w = *workers[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(w.m);
+        if(w.tasks.empty()) continue;
+        w.tasks.popFront(out);
+        queued.fetch_sub(1);
+        stealCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::finish() {
+    if(pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        doneCv.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    t_pool = this;
+    t_index = index;
+    Task task;
+    for(;;) {
+        if(popLocal(index, task) || steal(index, task)) {
+            task();
+            task = nullptr;
+            finish();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workCv.wait(lock, [&] { return quit.load() || queued.load() > 0; });
+        if(quit.load() && queued.load() == 0) return;
+    }
+}
+
+void ThreadPool::wait() {
+    Task task;
+    for(;;) {
+        if(pending.load() == 0) return;
+        if(steal(0, task)) {
+            task();
+            task = nullptr;
+            finish();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        doneCv.wait(lock, [&] { return pending.load() == 0 || queued.load() > 0; });
+    }
+}
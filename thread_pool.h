@@ -0,0 +1,83 @@
+// thread_pool.h - small work-stealing thread pool
+// Every worker owns a deque: it pushes and pops its own work at the back
+// and, when empty, steals from the front of another worker's deque, so
+// tasks that spawn tasks stay local and idle cores pick up the rest.
+// Tasks submitted from outside the pool are dealt round-robin. A task whose
+// captures fit std::function's inline storage (a pointer and an index) is
+// submitted and run without touching the heap.
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // 0 threads = one per hardware thread
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return unsigned(workers.size()); }
+
+    void submit(Task task);
+    // Block until every task submitted so far (and anything they spawned) has
+    // run; the calling thread helps while there is queued work. Not for use
+    // from inside a task (the task itself would count as unfinished).
+    void wait();
+
+    // f(begin, end) over [0, n) in chunks of `grain`, then wait()
+    template<class F>
+    void parallelFor(uint32_t n, uint32_t grain, F f) {
+        if(grain == 0) grain = 1;
+        for(uint32_t b=0; b<n; b+=grain) {
+            uint32_t e = (n - b > grain) ? b + grain : n;
+            submit([f, b, e]() { f(b, e); });
+        }
+        wait();
+    }
+
+    // Tasks taken from another worker's deque since construction
+    uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+private:
+    // Double-ended queue on a growable ring: once it has grown to the deepest
+    // backlog it never allocates again (std::deque frees and re-allocates
+    // blocks as its window drifts, which a per-frame user would hit)
+    struct TaskRing {
+        std::vector<Task> slots;
+        size_t head = 0, count = 0;
+
+        bool empty() const { return count == 0; }
+        void pushBack(Task&& t);
+        void popBack(Task& out);
+        void popFront(Task& out);
+    };
+
+    struct Worker {
+        std::mutex m;
+        TaskRing tasks;
+        std::thread thread;
+    };
+
+    void workerLoop(unsigned index);
+    bool popLocal(unsigned index, Task& out);
+    bool steal(unsigned thief, Task& out);
+    void finish();
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<uint32_t> queued{0};     // tasks sitting in deques
+    std::atomic<uint32_t> pending{0};    // submitted and not yet finished
+    std::atomic<uint32_t> nextWorker{0};
+    std::atomic<uint64_t> stealCount{0};
+    std::atomic<bool> quit{false};
+    std::mutex sleepMutex;
+    std::condition_variable workCv, doneCv;
+};
@@ -0,0 +1,210 @@
+// dxanalyze.cpp - level solvability and difficulty analyzer
+// Plays each level headless with the autopilot paddle over many seeds and
+// random launch angles, spread over all cores by the work-stealing pool.
+// Reports clear rate, time to clear, lives lost and the bricks that are
+// hardest to reach.
+// Build: g++ -O2 -std=c++17 -pthread -I.. dxanalyze.cpp ../thread_pool.cpp ../autopilot.cpp
+//        ../game_world.cpp ../brick_grid.cpp ../brick_simd.cpp ../collision.cpp
+// Usage: dxanalyze [--levels 4x8,6x10] [--runs N] [--threads N] [--seed S] [--hz N]
+//                  [--pad-speed N] [--deflect N] [--aim-error N] [--max-seconds N]
+//                  [--no-powerups] [--hardest N] [--fixed]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "thread_pool.h"
+#include "autopilot.h"
+#include "fixed_point.h"
+
+struct Options {
+    std::vector<std::pair<int,int>> levels;
+    uint32_t runs = 10000;
+    unsigned threads = 0;
+    uint64_t seed = 1;
+    float hz = DEFAULT_SIM_HZ;
+    float padSpeed = 15.0f;              // GameWorld::padSpeed (px per key event)
+    float deflect = PADDLE_DEFLECT;
+    float aimError = 12.0f;
+    float maxSeconds = 600.0f;
+    bool powerUps = true;
+    bool fixed = false;                  // Q16.16 physics: identical reports on every build
+    int hardest = 5;
+};
+
+// Totals over a batch of runs; batches are merged in a fixed order so the
+// report doesn't depend on scheduling
+struct LevelStats {
+    uint64_t runs = 0, cleared = 0, lost = 0, timedOut = 0;
+    uint64_t ticks = 0;
+    double clearSeconds = 0.0;
+    uint64_t livesLost = 0;
+    std::vector<uint64_t> brickKills;       // runs in which the brick was destroyed
+    std::vector<double> brickKillSeconds;   // summed time of those kills
+
+    void init(uint32_t bricks) { brickKills.assign(bricks, 0); brickKillSeconds.assign(bricks, 0.0); }
+    void merge(const LevelStats& o) {
+        runs += o.runs; cleared += o.cleared; lost += o.lost; timedOut += o.timedOut;
+        ticks += o.ticks; clearSeconds += o.clearSeconds; livesLost += o.livesLost;
+        for(size_t i=0; i<brickKills.size(); i++) {
+            brickKills[i] += o.brickKills[i];
+            brickKillSeconds[i] += o.brickKillSeconds[i];
+        }
+    }
+};
+
+static void launchAtRandomAngle(GameWorld& w, SimRng& rng) {
+    float speed = std::sqrt(BALL_SPEED_X*BALL_SPEED_X + BALL_SPEED_Y*BALL_SPEED_Y);
+    if(w.physics == PhysicsMode::FIXED) {
+        // no libm: a direction in the same 25..155 degree fan (x spans +-cot 25deg),
+        // normalised in Q16.16
+        fix x = fixMul(toFix(rng.nextFloat() * 2.0f - 1.0f), 140542), y = FIX_ONE;
+        fix len = fixSqrtWide(int64_t(x)*x + int64_t(y)*y);
+        w.balls.vx[0] = fixToFloat(fixMul(fixDiv(x, len), toFix(speed)));
+        w.balls.vy[0] = fixToFloat(fixMul(fixDiv(y, len), toFix(speed)));
+        return;
+    }
+    float a = (25.0f + 130.0f * rng.nextFloat()) * 3.14159265f / 180.0f;
+    w.balls.vx[0] = std::cos(a) * speed;
+    w.balls.vy[0] = std::sin(a) * speed;
+}
+
+static void playRun(const Options& o, int rows, int cols, uint64_t seed, LevelStats& st) {
+    GameWorld w(seed);
+    w.padSpeed = o.padSpeed;
+    w.paddleDeflect = o.deflect;
+    if(!o.powerUps) w.powerUpChance = 0.0f;
+    if(o.fixed) w.physics = PhysicsMode::FIXED;
+    w.resetLevel(rows, cols);
+
+    SimRng rng;
+    rng.seed(seed ^ 0xA5A5A5A5DEADBEEFull);
+    AutopilotParams ap;
+    ap.maxSpeed = o.padSpeed * KEY_REPEAT_HZ;
+    ap.aimError = o.aimError;
+    Autopilot pilot(ap);
+
+    float dt = 1.0f / o.hz;
+    uint64_t maxTicks = uint64_t(o.maxSeconds * o.hz);
+    uint64_t t = 0;
+    for(; t<maxTicks && !w.roundOver(); t++) {
+        if(w.ballStuckToPaddle) launchAtRandomAngle(w, rng);
+        GameInput in = pilot.update(w, dt, rng);
+        w.step(in, dt);
+        for(const SimEvent& e : w.events) {
+            if(e.type == SimEventType::BRICK_HIT) {
+                st.brickKills[e.brick]++;
+                st.brickKillSeconds[e.brick] += double(t + 1) * dt;
+            } else if(e.type == SimEventType::LOSE_LIFE) {
+                st.livesLost++;
+            }
+        }
+    }
+    st.runs++;
+    st.ticks += t;
+    if(w.round == RoundState::CLEARED) { st.cleared++; st.clearSeconds += double(t) * dt; }
+    else if(w.round == RoundState::LOST) st.lost++;
+    else st.timedOut++;
+}
+
+static bool parseLevels(const char* s, std::vector<std::pair<int,int>>& out) {
+    out.clear();
+    while(*s) {
+        int r = 0, c = 0, n = 0;
+        if(std::sscanf(s, "%dx%d%n", &r, &c, &n) != 2 || r < 1 || c < 1) return false;
+        out.push_back({r, c});
+        s += n;
+        if(*s == ',') s++;
+    }
+    return !out.empty();
+}
+
+static void report(const Options& o, int rows, int cols, const LevelStats& st, const GameWorld& layout) {
+    double n = double(std::max<uint64_t>(1, st.runs));
+    std::printf("level %dx%d: %llu runs\n", rows, cols, (unsigned long long)st.runs);
+    std::printf("  clear rate      %6.2f%%  (lost %.2f%%, timed out %.2f%%)\n",
+                100.0 * st.cleared / n, 100.0 * st.lost / n, 100.0 * st.timedOut / n);
+    if(st.cleared) std::printf("  time to clear   %6.1f s (mean of cleared runs)\n", st.clearSeconds / st.cleared);
+    else           std::printf("  time to clear      n/a\n");
+    std::printf("  lives lost      %6.2f per run\n", double(st.livesLost) / n);
+
+    // Hardest first: least often destroyed, then destroyed latest
+    std::vector<uint32_t> order(st.brickKills.size());
+    for(uint32_t i=0; i<order.size(); i++) order[i] = i;
+    auto meanKill = [&](uint32_t i) { return st.brickKills[i] ? st.brickKillSeconds[i] / st.brickKills[i] : 1e30; };
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        if(st.brickKills[a] != st.brickKills[b]) return st.brickKills[a] < st.brickKills[b];
+        if(meanKill(a) != meanKill(b)) return meanKill(a) > meanKill(b);
+        return a < b;
+    });
+    int shown = std::min<int>(o.hardest, int(order.size()));
+    if(shown > 0) std::printf("  hardest bricks  (position, destroyed in %% of runs, mean time destroyed)\n");
+    for(int k=0; k<shown; k++) {
+        uint32_t i = order[k];
+        std::printf("    (%5.0f,%5.0f)  %6.2f%%  ", layout.bricks.x[i], layout.bricks.y[i], 100.0 * st.brickKills[i] / n);
+        if(st.brickKills[i]) std::printf("%6.1f s\n", meanKill(i));
+        else std::printf("     never\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options o;
+    o.levels.push_back({4, 8});
+    for(int i=1; i<argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if(a == "--levels" && hasValue) {
+            if(!parseLevels(argv[++i], o.levels)) { std::fprintf(stderr, "dxanalyze: bad --levels\n"); return 2; }
+        }
+        else if(a == "--runs" && hasValue) o.runs = uint32_t(std::max(1, std::atoi(argv[++i])));
+        else if(a == "--threads" && hasValue) o.threads = unsigned(std::max(0, std::atoi(argv[++i])));
+        else if(a == "--seed" && hasValue) o.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if(a == "--hz" && hasValue) o.hz = std::max(10.0f, float(std::atof(argv[++i])));
+        else if(a == "--pad-speed" && hasValue) o.padSpeed = float(std::atof(argv[++i]));
+        else if(a == "--deflect" && hasValue) o.deflect = float(std::atof(argv[++i]));
+        else if(a == "--aim-error" && hasValue) o.aimError = float(std::atof(argv[++i]));
+        else if(a == "--max-seconds" && hasValue) o.maxSeconds = float(std::atof(argv[++i]));
+        else if(a == "--hardest" && hasValue) o.hardest = std::atoi(argv[++i]);
+        else if(a == "--no-powerups") o.powerUps = false;
+        else if(a == "--fixed") o.fixed = true;
+        else { std::fprintf(stderr, "dxanalyze: unknown option %s\n", a.c_str()); return 2; }
+    }
+
+    ThreadPool pool(o.threads);
+    std::printf("%u threads, %u runs per level, seed %llu\n", pool.size(), o.runs, (unsigned long long)o.seed);
+    const uint32_t RUNS_PER_TASK = 16;
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t totalTicks = 0;
+    for(size_t l=0; l<o.levels.size(); l++) {
+        int rows = o.levels[l].first, cols = o.levels[l].second;
+        GameWorld layout;
+        layout.resetLevel(rows, cols);
+        uint32_t tasks = (o.runs + RUNS_PER_TASK - 1) / RUNS_PER_TASK;
+        std::vector<LevelStats> partial(tasks);
+        for(auto& p : partial) p.init(layout.bricks.count);
+
+        pool.parallelFor(o.runs, RUNS_PER_TASK, [&](uint32_t begin, uint32_t end) {
+            LevelStats& st = partial[begin / RUNS_PER_TASK];
+            for(uint32_t r=begin; r<end; r++) {
+                // one seed per (level, run), independent of thread count
+                SimRng mix;
+                mix.seed(o.seed * 0x9E3779B97F4A7C15ull + uint64_t(l) * 0x100000001B3ull + r);
+                playRun(o, rows, cols, mix.next(), st);
+            }
+        });
+
+        LevelStats total;
+        total.init(layout.bricks.count);
+        for(const auto& p : partial) total.merge(p);
+        totalTicks += total.ticks;
+        report(o, rows, cols, total, layout);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::printf("%.2f s wall, %.1fM simulated ticks (%.1fM ticks/s), %llu steals\n", secs, totalTicks / 1e6,
+                totalTicks / 1e6 / std::max(1e-9, secs), (unsigned long long)pool.steals());
+    return 0;
+}
@@ -0,0 +1,95 @@
+// dxlevel.cpp - convert, generate and time level files
+// Build: g++ -O2 -std=c++17 -I.. dxlevel.cpp ../level.cpp ../asset_pack.cpp ../lz4_block.cpp
+//        ../brick_grid.cpp ../brick_simd.cpp ../collision.cpp
+// Usage: dxlevel <in.lvl> <out.lvb>          text level -> binary
+//        dxlevel --generate N <out.lvb>      N bricks stacked upwards from the playfield
+//        dxlevel --bench <level>             load time, then a window scrolled over the level
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "level.h"
+#include "asset_pack.h"
+
+static const float VIEW_H = 700.0f;
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool writeFile(const char* path, const std::vector<uint8_t>& bytes) {
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+    return bool(f);
+}
+
+static int convert(const char* in, const char* out) {
+    MappedFile file;
+    if(!file.open(in)) { std::fprintf(stderr, "cannot open %s\n", in); return 1; }
+    BrickStore s;
+    std::string error;
+    if(!parseLevelText(reinterpret_cast<const char*>(file.data()), file.size(), s, error)) {
+        std::fprintf(stderr, "%s: %s\n", in, error.c_str());
+        return 1;
+    }
+    std::vector<uint8_t> bytes;
+    if(!writeLevelBinary(s, bytes) || !writeFile(out, bytes)) { std::fprintf(stderr, "cannot write %s\n", out); return 1; }
+    std::printf("%s: %u bricks, %zu colours -> %s (%zu bytes)\n", in, s.count, s.palette.size(), out, bytes.size());
+    return 0;
+}
+
+// 18 columns of 44x18 bricks per row, rows climbing from y = 100
+static int generate(uint32_t n, const char* out) {
+    BrickStore s;
+    s.reserve(n);
+    for(int k=0; k<4; k++) s.addColor({0.3f + 0.15f * k, 0.8f - 0.15f * k, 0.5f, 1.0f});
+    for(uint32_t i=0; i<n; i++) {
+        uint32_t row = i / 18, col = i % 18;
+        s.add(10.0f + col * 49.0f, 100.0f + row * 22.0f, 44.0f, 18.0f, uint16_t(row % 4), uint8_t(1 + row % 3));
+    }
+    std::vector<uint8_t> bytes;
+    if(!writeLevelBinary(s, bytes) || !writeFile(out, bytes)) { std::fprintf(stderr, "cannot write %s\n", out); return 1; }
+    std::printf("%u bricks -> %s (%zu bytes)\n", n, out, bytes.size());
+    return 0;
+}
+
+static int bench(const char* path) {
+    double t0 = now();
+    PreparedLevel level;
+    std::string error;
+    if(!prepareLevelFile(path, 0.0f, VIEW_H, level, error)) { std::fprintf(stderr, "%s: %s\n", path, error.c_str()); return 1; }
+    double t1 = now();
+    std::printf("%s: %s level, %u bricks resident, %u outside the window, loaded in %.3f ms\n", path,
+                level.streamed ? "binary" : "text", level.bricks.count, level.notResident(), (t1 - t0) * 1e3);
+    if(!level.streamed) return 0;
+
+    // Scroll a screen-high window up the level, killing every 7th resident
+    // brick on the way so the destroyed set has to survive re-streaming
+    LevelStream& st = level.stream;
+    int moves = 0;
+    double worst = 0.0, total = 0.0;
+    float top = 100.0f + (st.totalBricks() / 18 + 1) * 22.0f;
+    for(float y=0.0f; y<top; y+=VIEW_H / 8) {
+        for(uint32_t i=0; i<level.bricks.count; i+=7) level.bricks.setAlive(i, false);
+        double a = now();
+        if(!st.setWindow(y, y + VIEW_H, &level.bricks, level.bricks)) continue;
+        level.grid.build(level.bricks);
+        double d = now() - a;
+        worst = std::max(worst, d);
+        total += d;
+        moves++;
+    }
+    std::printf("scrolled over %.0f px: %d re-streams, %.3f ms average, %.3f ms worst, %u of %u chunks resident at the top\n",
+                top, moves, total / std::max(1, moves) * 1e3, worst * 1e3, st.residentChunks(), st.chunkCount());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if(argc == 4 && std::strcmp(argv[1], "--generate") == 0) return generate(uint32_t(std::strtoul(argv[2], nullptr, 10)), argv[3]);
+    if(argc == 3 && std::strcmp(argv[1], "--bench") == 0) return bench(argv[2]);
+    if(argc == 3 && argv[1][0] != '-') return convert(argv[1], argv[2]);
+    std::fprintf(stderr, "usage: dxlevel <in.lvl> <out.lvb> | --generate N <out.lvb> | --bench <level>\n");
+    return 2;
+}
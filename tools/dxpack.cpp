@@ -0,0 +1,56 @@
+// dxpack.cpp - build an asset pack (asset_pack.h) from a directory
+// Usage: dxpack [--lz4] <asset dir> <out.pak>
+//        dxpack --list <pack>
+// Build: g++ -O2 -std=c++17 -I.. dxpack.cpp ../asset_pack.cpp ../lz4_block.cpp
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "asset_pack.h"
+
+namespace fs = std::filesystem;
+
+static int listPack(const char* path) {
+    AssetPack pack;
+    if(!pack.open(path)) { std::fprintf(stderr, "dxpack: %s is not a valid pack\n", path); return 1; }
+    for(uint32_t i=0; i<pack.count(); i++) {
+        const PackEntry& e = pack.entry(i);
+        std::printf("%-48s %10llu %10llu %s @%llu\n", e.name, (unsigned long long)e.rawSize,
+                    (unsigned long long)e.storedSize, e.codec == uint32_t(PackCodec::LZ4) ? "lz4" : "raw",
+                    (unsigned long long)e.offset);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    bool lz4 = false;
+    int arg = 1;
+    if(argc == 3 && std::strcmp(argv[1], "--list") == 0) return listPack(argv[2]);
+    if(arg < argc && std::strcmp(argv[arg], "--lz4") == 0) { lz4 = true; arg++; }
+    if(argc - arg != 2) {
+        std::fprintf(stderr, "usage: dxpack [--lz4] <asset dir> <out.pak>\n       dxpack --list <pack>\n");
+        return 2;
+    }
+    fs::path root = argv[arg];
+    std::error_code ec;
+    std::vector<PackInput> files;
+    for(fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if(!it->is_regular_file()) continue;
+        PackInput in;
+        in.name = it->path().lexically_relative(root).generic_string();
+        std::ifstream f(it->path(), std::ios::binary);
+        in.bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        files.push_back(std::move(in));
+    }
+    if(ec) { std::fprintf(stderr, "dxpack: %s: %s\n", argv[arg], ec.message().c_str()); return 1; }
+
+    std::string error;
+    size_t count = files.size();
+    if(!writeAssetPack(argv[arg + 1], std::move(files), lz4, error)) {
+        std::fprintf(stderr, "dxpack: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("packed %zu files into %s\n", count, argv[arg + 1]);
+    return 0;
+}
@@ -0,0 +1,192 @@
+// dxversus.cpp - rollback versus over real UDP on localhost
+// Runs both peers of a versus match in one process, each on its own socket,
+// with the autopilot as both players and the link delayed/jittered/lossy as
+// asked. Time is simulated (one frame = 1/hz s), so a long match with 100 ms
+// of delay finishes in moments. At the end both peers' boards must be
+// bit-identical; the report shows how often and how deep the sessions
+// rolled back, and what a rollback of --max-prediction frames costs.
+// Build: cmake --build <dir> --target dxversus
+// Usage: dxversus [--frames N] [--hz N] [--delay ms] [--jitter ms] [--loss pct]
+//                 [--input-delay F] [--max-prediction F] [--seed S] [--level RxC|file] [--port P]
+//                 [--aim-error px] [--fixed]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "autopilot.h"
+#include "replay.h"
+#include "versus.h"
+
+struct Peer {
+    GameWorld boards[2];
+    VersusPeer net;
+    Autopilot pilot;
+    SimRng pilotRng;
+    double advanceSeconds = 0.0, worstAdvance = 0.0;
+    uint32_t advances = 0, stalls = 0;
+};
+
+static double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static PhysicsMode physics = PhysicsMode::FLOAT;
+
+static bool setupBoards(GameWorld boards[2], uint64_t seed, const std::string& level, float dt) {
+    for(int p=0; p<2; p++) {
+        ReplayHeader h;
+        h.seed = seed * 2 + uint64_t(p);
+        h.level = level;
+        h.stepSeconds = dt;
+        h.powerUpChance = 0.1f;
+        h.physics = physics;
+        if(!setupReplayWorld(h, boards[p])) return false;
+    }
+    return true;
+}
+
+// Restore, re-simulate `depth` frames of both boards: the worst-case repair.
+// Measured on fresh boards a second into play, with the balls moving.
+static double rollbackCost(uint64_t seed, const std::string& level, uint32_t depth, float dt) {
+    GameWorld boards[2];
+    setupBoards(boards, seed, level, dt);
+    GameInput in;
+    in.launch = true;
+    for(int f=0; f<int(1.0f / dt); f++) {
+        boards[0].step(in, dt);
+        boards[1].step(in, dt);
+    }
+    WorldSnapshot snap[2];
+    int reps = 2000;
+    double t0 = now();
+    for(int r=0; r<reps; r++) {
+        saveSnapshot(boards[0], snap[0]);
+        saveSnapshot(boards[1], snap[1]);
+        for(uint32_t f=0; f<depth; f++) {
+            boards[0].step(in, dt);
+            boards[1].step(in, dt);
+        }
+        restoreSnapshot(boards[0], snap[0]);
+        restoreSnapshot(boards[1], snap[1]);
+    }
+    return (now() - t0) / reps;
+}
+
+static double snapshotCost(GameWorld& w, bool restore) {
+    WorldSnapshot snap;
+    saveSnapshot(w, snap);
+    int reps = 200000;
+    double t0 = now();
+    for(int r=0; r<reps; r++) {
+        if(restore) restoreSnapshot(w, snap);
+        else saveSnapshot(w, snap);
+    }
+    return (now() - t0) / reps;
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = 3600;
+    float hz = 60.0f;
+    VersusConfig cfg;
+    std::string level = "4x8";
+    uint16_t basePort = 47310;
+    float aimError = 4.0f;
+    for(int i=1; i<argc; i++) {
+        const char* a = argv[i];
+        bool more = i + 1 < argc;
+        if(!std::strcmp(a, "--frames") && more) frames = uint32_t(std::atoi(argv[++i]));
+        else if(!std::strcmp(a, "--hz") && more) hz = float(std::max(10.0, std::atof(argv[++i])));
+        else if(!std::strcmp(a, "--delay") && more) cfg.link.delayMs = float(std::atof(argv[++i]));
+        else if(!std::strcmp(a, "--jitter") && more) cfg.link.jitterMs = float(std::atof(argv[++i]));
+        else if(!std::strcmp(a, "--loss") && more) cfg.link.lossPercent = float(std::atof(argv[++i]));
+        else if(!std::strcmp(a, "--input-delay") && more) cfg.inputDelay = uint32_t(std::atoi(argv[++i]));
+        else if(!std::strcmp(a, "--max-prediction") && more) cfg.maxPrediction = uint32_t(std::atoi(argv[++i]));
+        else if(!std::strcmp(a, "--seed") && more) cfg.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if(!std::strcmp(a, "--level") && more) level = argv[++i];
+        else if(!std::strcmp(a, "--port") && more) basePort = uint16_t(std::atoi(argv[++i]));
+        else if(!std::strcmp(a, "--aim-error") && more) aimError = float(std::atof(argv[++i]));
+        else if(!std::strcmp(a, "--fixed")) physics = PhysicsMode::FIXED;
+        else {
+            std::fprintf(stderr, "usage: dxversus [--frames N] [--hz N] [--delay ms] [--jitter ms] [--loss pct]\n"
+                                 "                [--input-delay F] [--max-prediction F] [--seed S] [--level L] [--port P]\n"
+                                 "                [--aim-error px] [--fixed]\n");
+            return 2;
+        }
+    }
+    float dt = 1.0f / hz;
+
+    static Peer peers[2];
+    for(int p=0; p<2; p++) {
+        if(!setupBoards(peers[p].boards, cfg.seed, level, dt)) { std::fprintf(stderr, "unknown level %s\n", level.c_str()); return 2; }
+        VersusConfig c = cfg;
+        c.localPlayer = p;
+        c.localPort = uint16_t(basePort + p);
+        c.remote.ip = 0x7F000001;
+        c.remote.port = uint16_t(basePort + 1 - p);
+        std::string error;
+        if(!peers[p].net.open(c, &peers[p].boards[0], &peers[p].boards[1], dt, error)) {
+            std::fprintf(stderr, "player %d: %s\n", p, error.c_str());
+            return 1;
+        }
+        peers[p].pilot.params.maxSpeed = peers[p].boards[p].padSpeed * KEY_REPEAT_HZ;
+        peers[p].pilot.params.aimError = aimError;
+        peers[p].pilotRng.seed(cfg.seed * 7 + uint64_t(p));
+    }
+
+    // Both peers tick once per simulated frame; a stalled peer just waits
+    double t = 0.0;
+    uint32_t ticks = 0, limit = frames * 20 + 1000;
+    for(; ticks < limit; ticks++) {
+        bool done = true;
+        for(int p=0; p<2; p++) {
+            Peer& pe = peers[p];
+            RollbackSession& s = pe.net.session();
+            pe.net.poll(t);
+            if(s.frame() < frames && s.canAdvance()) {
+                s.addLocalInput(pe.pilot.update(pe.boards[p], dt, pe.pilotRng));
+                double a = now();
+                s.advance();
+                double d = now() - a;
+                pe.advanceSeconds += d;
+                pe.worstAdvance = std::max(pe.worstAdvance, d);
+                pe.advances++;
+            } else if(s.frame() < frames) {
+                pe.stalls++;
+            }
+            pe.net.send(t);
+            done &= s.frame() >= frames && s.remoteConfirmed() >= frames;
+        }
+        if(done) break;
+        t += dt;
+    }
+    for(Peer& pe : peers) pe.net.session().repair();
+
+    bool same = true;
+    for(int b=0; b<2; b++) same &= worldStateHash(peers[0].boards[b]) == worldStateHash(peers[1].boards[b]);
+    std::printf("%u frames at %.0f Hz, link %.0f +- %.0f ms, %.1f%% loss, input delay %u, max prediction %u\n",
+                frames, hz, cfg.link.delayMs, cfg.link.jitterMs, cfg.link.lossPercent, cfg.inputDelay, cfg.maxPrediction);
+    for(int p=0; p<2; p++) {
+        const Peer& pe = peers[p];
+        const RollbackSession& s = pe.net.session();
+        const RollbackStats& st = s.stats();
+        const VersusNetStats& ns = pe.net.netStats();
+        std::printf("player %d: frame %u, score %d vs %d, %llu rollbacks (avg %.1f, max %u frames), %u stalled ticks\n"
+                    "          %llu packets sent, %llu dropped, %llu received; advance %.1f us avg, %.1f us worst\n",
+                    p, s.frame(), pe.boards[p].score, pe.boards[1 - p].score,
+                    (unsigned long long)st.rollbacks, st.rollbacks ? double(st.resimulatedFrames) / st.rollbacks : 0.0,
+                    st.maxDepth, pe.stalls,
+                    (unsigned long long)ns.packetsSent, (unsigned long long)ns.packetsDropped,
+                    (unsigned long long)ns.packetsReceived,
+                    pe.advanceSeconds / std::max(1u, pe.advances) * 1e6, pe.worstAdvance * 1e6);
+        if(s.desyncFrame() >= 0) std::printf("          checksum mismatch at frame %lld\n", (long long)s.desyncFrame());
+    }
+    std::printf("snapshot save %.0f ns, restore %.0f ns; %u-frame rollback of both boards %.1f us (frame budget %.0f us)\n",
+                snapshotCost(peers[0].boards[0], false) * 1e9, snapshotCost(peers[0].boards[0], true) * 1e9,
+                cfg.maxPrediction, rollbackCost(cfg.seed, level, cfg.maxPrediction, dt) * 1e6, 1e6 / hz);
+    bool desync = peers[0].net.session().desyncFrame() >= 0 || peers[1].net.session().desyncFrame() >= 0;
+    bool finished = peers[0].net.session().frame() >= frames && peers[1].net.session().frame() >= frames;
+    std::printf("%s\n", !finished ? "DID NOT FINISH" : (same && !desync) ? "boards identical on both peers" : "DESYNC");
+    return finished && same && !desync ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// versus.cpp - two-player rollback versus over UDP
+#include "versus.h"
+#include <algorithm>
+#include <cstring>
+
+static const uint32_t VERSUS_MAGIC = 0x53565844;    // "DXVS"
+static const uint32_t MAX_INPUTS_PER_PACKET = 32;
+static const size_t HEADER_BYTES = 26;
+static const size_t INPUT_BYTES = 9;
+
+enum : uint8_t { VS_TARGET = 1, VS_LAUNCH = 2 };
+
+// Packet (little-endian):
+//   u32 magic | u32 session | u8 player | u32 ack | u32 checkFrame | u32 checkHash
+//   | u32 firstFrame | u8 count | count x (u8 flags, f32 padMove, f32 padTarget)
+template<class T>
+static void put(std::vector<uint8_t>& out, T v) {
+    uint8_t b[sizeof(T)];
+    std::memcpy(b, &v, sizeof(T));
+    out.insert(out.end(), b, b + sizeof(T));
+}
+
+template<class T>
+static T get(const uint8_t*& p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+}
+
+bool VersusPeer::open(const VersusConfig& c, GameWorld* board0, GameWorld* board1, float dt, std::string& error) {
+    cfg = c;
+    if(c.localPlayer != 0 && c.localPlayer != 1) { error = "player must be 0 or 1"; return false; }
+    // A scroll can't be rolled back: snapshots hold neither the stream nor
+    // the bricks it pages out
+    if(board0->streamsLevel() || board1->streamsLevel()) {
+        error = "streamed levels can't be played in versus";
+        return false;
+    }
+    if(!socket.open(c.localPort)) { error = "cannot bind UDP port " + std::to_string(c.localPort); return false; }
+    rollback.start(board0, board1, c.localPlayer, dt, c.inputDelay, c.maxPrediction);
+    sessionId = uint32_t(c.seed ^ (c.seed >> 32)) ^ 0x5A5A5A5Au;
+    remoteAck = 0;
+    outgoing.clear();
+    linkRng.seed(c.seed * 2 + uint64_t(c.localPlayer));
+    net = VersusNetStats();
+    return true;
+}
+
+void VersusPeer::close() {
+    socket.close();
+    outgoing.clear();
+}
+
+void VersusPeer::poll(double) {
+    uint8_t buf[1024];
+    NetAddress from;
+    int n;
+    while((n = socket.receive(buf, sizeof(buf), &from)) >= 0) handlePacket(buf, size_t(n));
+}
+
+void VersusPeer::handlePacket(const uint8_t* p, size_t n) {
+    const uint8_t* end = p + n;
+    if(n < HEADER_BYTES || get<uint32_t>(p) != VERSUS_MAGIC || get<uint32_t>(p) != sessionId ||
+       get<uint8_t>(p) != uint8_t(1 - cfg.localPlayer)) {
+        net.packetsRejected++;
+        return;
+    }
+    uint32_t ack = get<uint32_t>(p);
+    uint32_t checkFrame = get<uint32_t>(p);
+    uint32_t checkHash = get<uint32_t>(p);
+    uint32_t first = get<uint32_t>(p);
+    uint32_t count = get<uint8_t>(p);
+    if(size_t(end - p) < count * INPUT_BYTES) {
+        net.packetsRejected++;
+        return;
+    }
+    net.packetsReceived++;
+    remoteAck = std::max(remoteAck, ack);
+    if(checkFrame != UINT32_MAX) rollback.addRemoteChecksum(checkFrame, checkHash);
+    for(uint32_t i=0; i<count; i++) {
+        uint8_t flags = get<uint8_t>(p);
+        GameInput in;
+        in.padMove = get<float>(p);
+        in.padTarget = get<float>(p);
+        in.hasPadTarget = (flags & VS_TARGET) != 0;
+        in.launch = (flags & VS_LAUNCH) != 0;
+        if(!in.hasPadTarget) in.padTarget = 0.0f;
+        rollback.addRemoteInput(first + i, in);
+    }
+}
+
+void VersusPeer::send(double now) {
+    uint32_t end = rollback.localInputEnd();
+    uint32_t first = std::max(remoteAck, end > MAX_INPUTS_PER_PACKET ? end - MAX_INPUTS_PER_PACKET : 0u);
+    uint32_t checkFrame = rollback.latestChecksumFrame(), checkHash = 0;
+    if(checkFrame != UINT32_MAX) rollback.checksum(checkFrame, checkHash);
+
+    packet.clear();
+    put(packet, VERSUS_MAGIC);
+    put(packet, sessionId);
+    put(packet, uint8_t(cfg.localPlayer));
+    put(packet, rollback.remoteConfirmed());
+    put(packet, checkFrame);
+    put(packet, checkHash);
+    put(packet, first);
+    put(packet, uint8_t(end - first));
+    for(uint32_t f=first; f<end; f++) {
+        const GameInput& in = rollback.localInput(f);
+        put(packet, uint8_t((in.hasPadTarget ? VS_TARGET : 0) | (in.launch ? VS_LAUNCH : 0)));
+        put(packet, in.padMove);
+        put(packet, in.hasPadTarget ? in.padTarget : 0.0f);
+    }
+
+    const LinkConditions& l = cfg.link;
+    if(l.lossPercent > 0.0f && linkRng.nextFloat() * 100.0f < l.lossPercent) {
+        net.packetsDropped++;
+    } else {
+        double delay = (l.delayMs + (linkRng.nextFloat() * 2.0f - 1.0f) * l.jitterMs) * 1e-3;
+        outgoing.push_back({now + std::max(0.0, delay), std::move(packet)});
+        if(!spare.empty()) {
+            packet = std::move(spare.back());
+            spare.pop_back();
+        } else {
+            packet = std::vector<uint8_t>();
+        }
+    }
+    for(size_t i=0; i<outgoing.size(); ) {
+        if(outgoing[i].due <= now) {
+            socket.sendTo(cfg.remote, outgoing[i].bytes.data(), outgoing[i].bytes.size());
+            net.packetsSent++;
+            spare.push_back(std::move(outgoing[i].bytes));
+            outgoing[i] = std::move(outgoing.back());
+            outgoing.pop_back();
+        } else {
+            i++;
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// versus.h - two-player rollback versus over UDP
+// Each packet carries the sender's not-yet-acknowledged inputs (so a lost
+// packet is covered by the next one), an ack of the inputs it has received
+// and its latest state checksum. LinkConditions hold outgoing packets back
+// and drop some of them, to try the netcode against a bad network on
+// localhost.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "net_udp.h"
+#include "rollback.h"
+
+struct LinkConditions {
+    float delayMs = 0.0f;
+    float jitterMs = 0.0f;    // each packet gets delayMs +- jitterMs (packets may reorder)
+    float lossPercent = 0.0f;
+};
+
+struct VersusConfig {
+    int localPlayer = 0;      // 0 or 1; the other peer must use the other one
+    uint16_t localPort = 0;
+    NetAddress remote;
+    uint64_t seed = 1;        // both peers must agree; packets from other sessions are ignored
+    uint32_t inputDelay = 2;
+    uint32_t maxPrediction = 8;
+    LinkConditions link;
+};
+
+struct VersusNetStats {
+    uint64_t packetsSent = 0, packetsDropped = 0, packetsReceived = 0, packetsRejected = 0;
+};
+
+class VersusPeer {
+public:
+    // Both boards must already hold the same level on both peers, and not a
+    // streamed one
+    bool open(const VersusConfig& c, GameWorld* board0, GameWorld* board1, float dt, std::string& error);
+    void close();
+
+    // Take in every waiting packet; call before advancing
+    void poll(double now);
+    // Queue a packet with the unacknowledged local inputs and push out the
+    // ones whose artificial delay has passed; call after advancing
+    void send(double now);
+
+    RollbackSession& session() { return rollback; }
+    const RollbackSession& session() const { return rollback; }
+    bool heardFromRemote() const { return net.packetsReceived > 0; }
+    const VersusNetStats& netStats() const { return net; }
+
+private:
+    struct Delayed {
+        double due;
+        std::vector<uint8_t> bytes;
+    };
+
+    void handlePacket(const uint8_t* p, size_t n);
+
+    VersusConfig cfg;
+    UdpSocket socket;
+    RollbackSession rollback;
+    uint32_t sessionId = 0;
+    uint32_t remoteAck = 0;        // our frames the remote has
+    // Packet buffers move between `packet`, `outgoing` and `spare` and are
+    // never freed, so steady sending doesn't allocate
+    std::vector<Delayed> outgoing;
+    std::vector<uint8_t> packet;
+    std::vector<std::vector<uint8_t>> spare;
+    SimRng linkRng;
+    VersusNetStats net;
+};
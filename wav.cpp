@@ -0,0 +1,101 @@
+// wav.cpp - RIFF/WAVE decoding into the mixer's sample format
+#include "wav.h"
+#include <cstring>
+#include <algorithm>
+
+static uint16_t rd16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+static uint32_t rd32(const uint8_t* p) { return uint32_t(p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24)); }
+
+// One source sample as a float in [-1,1]
+static float readSample(const uint8_t* p, int bits, bool isFloat) {
+    if(isFloat) { float f; std::memcpy(&f, p, 4); return f; }
+    switch(bits) {
+        case 8:  return (float(p[0]) - 128.0f) / 128.0f;
+        case 16: return float(int16_t(rd16(p))) / 32768.0f;
+        case 24: return float(int32_t(uint32_t(p[0] << 8 | p[1] << 16 | uint32_t(p[2]) << 24)) >> 8) / 8388608.0f;
+        default: return float(int32_t(rd32(p))) / 2147483648.0f;
+    }
+}
+
+bool decodeWav(const uint8_t* data, size_t size, DecodedSound& out, bool borrow) {
+    if(size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) return false;
+    int format = 0, channels = 0, rate = 0, bits = 0;
+    const uint8_t* pcm = nullptr;
+    size_t pcmBytes = 0;
+    size_t pos = 12;
+    while(pos + 8 <= size) {
+        uint32_t len = rd32(data + pos + 4);
+        const uint8_t* body = data + pos + 8;
+        size_t avail = std::min<size_t>(len, size - pos - 8);
+        if(std::memcmp(data + pos, "fmt ", 4) == 0 && avail >= 16) {
+            format = rd16(body);
+            channels = rd16(body + 2);
+            rate = int(rd32(body + 4));
+            bits = rd16(body + 14);
+            if(format == 0xFFFE && avail >= 26) format = rd16(body + 24);   // WAVE_FORMAT_EXTENSIBLE
+        } else if(std::memcmp(data + pos, "data", 4) == 0) {
+            pcm = body;
+            pcmBytes = avail;
+        }
+        pos += 8 + len + (len & 1);
+    }
+    bool isFloat = (format == 3 && bits == 32);
+    if(!pcm || channels < 1 || rate <= 0 || !(format == 1 || isFloat)) return false;
+    if(!isFloat && bits != 8 && bits != 16 && bits != 24 && bits != 32) return false;
+
+    size_t stride = size_t(bits / 8) * channels;
+    size_t srcFrames = pcmBytes / stride;
+    if(borrow && format == 1 && bits == 16 && channels == MIX_CHANNELS && rate == MIX_RATE &&
+       (reinterpret_cast<uintptr_t>(pcm) & 1) == 0) {
+        out.owned.clear();
+        out.data = reinterpret_cast<const int16_t*>(pcm);
+        out.frameCount = srcFrames;
+        return true;
+    }
+    size_t dstFrames = size_t(double(srcFrames) * MIX_RATE / rate);
+    out.owned.assign(dstFrames * MIX_CHANNELS, 0);
+    out.data = out.owned.data();
+    out.frameCount = dstFrames;
+    double step = double(rate) / MIX_RATE;
+    for(size_t i=0; i<dstFrames; i++) {
+        double src = i * step;
+        size_t i0 = std::min(size_t(src), srcFrames - 1);
+        size_t i1 = std::min(i0 + 1, srcFrames - 1);
+        float frac = float(src - double(i0));
+        for(int c=0; c<MIX_CHANNELS; c++) {
+            int sc = std::min(c, channels - 1);
+            float a = readSample(pcm + i0*stride + sc*(bits/8), bits, isFloat);
+            float b = readSample(pcm + i1*stride + sc*(bits/8), bits, isFloat);
+            float v = a + (b - a) * frac;
+            out.owned[i*MIX_CHANNELS + c] = int16_t(std::max(-32768.0f, std::min(32767.0f, v * 32767.0f)));
+        }
+    }
+    return true;
+}
+
+bool loadWavFile(const char* path, DecodedSound& out) {
+    std::FILE* f = std::fopen(path, "rb");
+    if(!f) return false;
+    std::vector<uint8_t> bytes;
+    std::fseek(f, 0, SEEK_END);
+    long len = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    if(len > 0) {
+        bytes.resize(size_t(len));
+        if(std::fread(bytes.data(), 1, bytes.size(), f) != bytes.size()) bytes.clear();
+    }
+    std::fclose(f);
+    return !bytes.empty() && decodeWav(bytes.data(), bytes.size(), out);
+}
+
+bool writeWavHeader(std::FILE* f, int rate, int channels, uint32_t dataBytes) {
+    uint8_t h[44];
+    auto w16 = [&](int at, uint16_t v) { h[at] = uint8_t(v); h[at+1] = uint8_t(v >> 8); };
+    auto w32 = [&](int at, uint32_t v) { for(int i=0;i<4;i++) h[at+i] = uint8_t(v >> (8*i)); };
+    std::memcpy(h, "RIFF", 4); w32(4, 36 + dataBytes);
+    std::memcpy(h + 8, "WAVEfmt ", 8); w32(16, 16);
+    w16(20, 1); w16(22, uint16_t(channels)); w32(24, uint32_t(rate));
+    w32(28, uint32_t(rate * channels * 2)); w16(32, uint16_t(channels * 2)); w16(34, 16);
+    std::memcpy(h + 36, "data", 4); w32(40, dataBytes);
+    return std::fwrite(h, 1, sizeof(h), f) == sizeof(h);
+}
@@ -0,0 +1,30 @@
+// wav.h - RIFF/WAVE decoding into the mixer's sample format
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+static const int MIX_RATE = 44100;
+static const int MIX_CHANNELS = 2;
+
+// Interleaved 16-bit stereo at MIX_RATE, ready to be mixed as-is. `data`
+// points either at `owned` or straight into the caller's buffer when the
+// source already had the mixer format (see decodeWav's `borrow`).
+struct DecodedSound {
+    std::vector<int16_t> owned;
+    const int16_t* data = nullptr;
+    size_t frameCount = 0;
+    size_t frames() const { return frameCount; }
+    bool empty() const { return frameCount == 0; }
+};
+
+// Decode a PCM (8/16/24/32-bit) or 32-bit float WAV held in memory; mono is
+// duplicated to both channels and other rates are resampled linearly.
+// With `borrow`, a 16-bit stereo MIX_RATE file is referenced in place instead
+// of copied, so `data` must then outlive `out` (e.g. a mapped asset pack).
+bool decodeWav(const uint8_t* data, size_t size, DecodedSound& out, bool borrow = false);
+bool loadWavFile(const char* path, DecodedSound& out);
+
+// Write interleaved 16-bit samples as a WAV file (used by the file sink)
+bool writeWavHeader(std::FILE* f, int rate, int channels, uint32_t dataBytes);